@@ -0,0 +1,981 @@
+// single_buffer_hash_setį
+// sĶ(ݭnC++20Aаȥ}ҳ̨Τƨassert)G
+//   g++ -std=c++20 -O2 -DNDEBUG -I.. benchmark.cpp -o benchmark -pthread
+//   cl /std:c++20 /O2 /DNDEBUG /EHsc /I.. benchmark.cpp
+// G
+//   ./benchmark [--quick] [--sizes=1024,65536] [--keys=int,u64,string,struct]
+//               [--dists=uniform,zipf,adversarial] [--containers=sbh,sbh_fastmod,sbh_incremental,sbh_huge_pages,std,open_addressing]
+//               [--ops=insert,find_hit,find_miss,find_hit_batched,erase_churn,erase_half,merge,iterate,rehash,copy,concurrent_insert,concurrent_find,find_under_writes]
+//               [--threads=1,2,4,8]
+// CӵGX@JSON(JSON Lines)AKHLuPG
+// sbh_huge_pagesHsbh_huge_page_allocatortmAPsbhfind_hit/find_missYiݥXTLBRvTAejƦMBɳ̩
+// jtmӦmmap/VirtualAllocAgLoperator newA]bytesPpeak_bytesu]tp2MBtm
+// hը̧ǥH--threads=CXCӰƶqU@Aw]1B2B4KKwơAiHݥXXi
+// find_under_writesb@ӼgJ̫򲾰PJPɴqŪ̪jM]RqAsbhsnapshot_single_buffer_hash_setPconcurrent_single_buffer_hash_set
+#include "single_buffer_hash_set.h"
+#include "concurrent_single_buffer_hash_set.h"
+#include "huge_page_allocator.h"
+#include "snapshot_single_buffer_hash_set.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <new>
+#include <random>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+// HNoperator new覡έptm줸ռ
+// CtmehOd@qYOjpAoperator delete]ॿT
+namespace memory {
+std::atomic<std::size_t> current{ 0 };
+std::atomic<std::size_t> peak{ 0 };
+constexpr std::size_t header_size = alignof(std::max_align_t);
+void* allocate(std::size_t size) {
+    void* block = std::malloc(size + header_size);
+    if (!block) {
+        throw std::bad_alloc();
+    }
+    *static_cast<std::size_t*>(block) = size;
+    std::size_t now = current.fetch_add(size, std::memory_order_relaxed) + size;
+    std::size_t old_peak = peak.load(std::memory_order_relaxed);
+    while (now > old_peak && !peak.compare_exchange_weak(old_peak, now, std::memory_order_relaxed)) {
+    }
+    return static_cast<char*>(block) + header_size;
+}
+void deallocate(void* p) noexcept {
+    if (p) {
+        void* block = static_cast<char*>(p) - header_size;
+        current.fetch_sub(*static_cast<std::size_t*>(block), std::memory_order_relaxed);
+        std::free(block);
+    }
+}
+void reset_peak() noexcept {
+    peak.store(current.load(std::memory_order_relaxed), std::memory_order_relaxed);
+}
+}
+void* operator new(std::size_t size) {
+    return memory::allocate(size);
+}
+void* operator new[](std::size_t size) {
+    return memory::allocate(size);
+}
+void operator delete(void* p) noexcept {
+    memory::deallocate(p);
+}
+void operator delete[](void* p) noexcept {
+    memory::deallocate(p);
+}
+void operator delete(void* p, std::size_t) noexcept {
+    memory::deallocate(p);
+}
+void operator delete[](void* p, std::size_t) noexcept {
+    memory::deallocate(p);
+}
+
+// ²檺}w}k(uʱ)XA@H
+// eq2At]lW0.75AɯdUӸO
+template <class Key, class Hash = std::hash<Key>, class Pred = std::equal_to<Key>>
+class open_addressing_set {
+    enum : std::uint8_t { empty = 0, full = 1, deleted = 2 };
+    std::vector<Key> slots;
+    std::vector<std::uint8_t> control;
+    std::size_t _size = 0;
+    std::size_t used = 0; // PӸO`
+    Hash hash;
+    Pred equal;
+    // Psbh_power_of_twoۦPVXơAϫƨƤ]
+    static std::size_t mix(std::size_t h) noexcept {
+        std::uint64_t x = h;
+        x ^= x >> 32;
+        x *= 0x9E3779B97F4A7C15;
+        x ^= x >> 32;
+        return static_cast<std::size_t>(x);
+    }
+    std::size_t mask() const noexcept {
+        return control.size() - 1;
+    }
+    void grow(std::size_t capacity) {
+        std::vector<Key> old_slots(capacity);
+        std::vector<std::uint8_t> old_control(capacity, empty);
+        old_slots.swap(slots);
+        old_control.swap(control);
+        _size = used = 0;
+        for (std::size_t i = 0; i < old_control.size(); ++i) {
+            if (old_control[i] == full) {
+                insert(std::move(old_slots[i]));
+            }
+        }
+    }
+public:
+    open_addressing_set() {
+        grow(16);
+    }
+    class const_iterator {
+        const open_addressing_set* set = nullptr;
+        std::size_t i = 0;
+        void skip() noexcept {
+            while (i < set->control.size() && set->control[i] != full) {
+                ++i;
+            }
+        }
+    public:
+        const_iterator() = default;
+        const_iterator(const open_addressing_set* s, std::size_t index) noexcept :set(s), i(index) {
+            skip();
+        }
+        const Key& operator*() const noexcept {
+            return set->slots[i];
+        }
+        const_iterator& operator++() noexcept {
+            ++i;
+            skip();
+            return *this;
+        }
+        bool operator==(const const_iterator& other) const noexcept {
+            return i == other.i;
+        }
+    };
+    const_iterator begin() const noexcept {
+        return const_iterator(this, 0);
+    }
+    const_iterator end() const noexcept {
+        return const_iterator(this, control.size());
+    }
+    std::size_t size() const noexcept {
+        return _size;
+    }
+    std::size_t bucket_count() const noexcept {
+        return control.size();
+    }
+    void rehash(std::size_t n) {
+        grow(std::bit_ceil((std::max)(n, _size * 4 / 3 + 1)));
+    }
+    template <class K>
+    std::pair<const_iterator, bool> insert(K&& key) {
+        if ((used + 1) * 4 > control.size() * 3) {
+            grow(_size * 4 + 1 > control.size() * 3 ? control.size() * 2 : control.size());
+        }
+        std::size_t i = mix(hash(key)) & mask();
+        std::size_t tombstone = std::size_t(-1);
+        while (control[i] != empty) {
+            if (control[i] == full && equal(slots[i], key)) {
+                return { const_iterator(this, i), false };
+            }
+            if (control[i] == deleted && tombstone == std::size_t(-1)) {
+                tombstone = i;
+            }
+            i = (i + 1) & mask();
+        }
+        if (tombstone != std::size_t(-1)) {
+            i = tombstone;
+        }
+        else {
+            ++used;
+        }
+        slots[i] = std::forward<K>(key);
+        control[i] = full;
+        ++_size;
+        return { const_iterator(this, i), true };
+    }
+    const_iterator find(const Key& key) const {
+        std::size_t i = mix(hash(key)) & mask();
+        while (control[i] != empty) {
+            if (control[i] == full && equal(slots[i], key)) {
+                return const_iterator(this, i);
+            }
+            i = (i + 1) & mask();
+        }
+        return end();
+    }
+    std::size_t erase(const Key& key) {
+        std::size_t i = mix(hash(key)) & mask();
+        while (control[i] != empty) {
+            if (control[i] == full && equal(slots[i], key)) {
+                control[i] = deleted;
+                slots[i] = Key();
+                --_size;
+                return 1;
+            }
+            i = (i + 1) & mask();
+        }
+        return 0;
+    }
+};
+
+// 64줸ժjAuHidp⫢ƭȻP
+struct large_key {
+    std::uint64_t id = 0;
+    std::uint64_t payload[7] = {};
+    bool operator==(const large_key& other) const noexcept {
+        return id == other.id;
+    }
+};
+template <>
+struct std::hash<large_key> {
+    std::size_t operator()(const large_key& key) const noexcept {
+        return std::hash<std::uint64_t>{}(key.id);
+    }
+};
+
+// ѽsAPsOҲͤP
+template <class Key>
+Key make_key(std::uint64_t id) {
+    if constexpr (std::is_same_v<Key, std::string>) {
+        // צbSSOd򤺪ur
+        char buffer[24];
+        int length = std::snprintf(buffer, sizeof(buffer), "k%llx", static_cast<unsigned long long>(id));
+        return std::string(buffer, static_cast<std::size_t>(length));
+    }
+    else if constexpr (std::is_same_v<Key, large_key>) {
+        large_key key;
+        key.id = id;
+        key.payload[0] = id;
+        return key;
+    }
+    else {
+        return static_cast<Key>(id);
+    }
+}
+// gVXơAs򪺽s
+inline std::uint64_t splitmix64(std::uint64_t x) noexcept {
+    x += 0x9E3779B97F4A7C15;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EB;
+    return x ^ (x >> 31);
+}
+inline std::uint32_t fmix32(std::uint32_t x) noexcept {
+    x ^= x >> 16;
+    x *= 0x85EBCA6B;
+    x ^= x >> 13;
+    x *= 0xC2B2AE35;
+    x ^= x >> 16;
+    return x;
+}
+
+enum class distribution { uniform, zipf, adversarial };
+const char* to_string(distribution d) {
+    switch (d) {
+    case distribution::uniform: return "uniform";
+    case distribution::zipf: return "zipf";
+    default: return "adversarial";
+    }
+}
+
+// countӤۦPGenӷ|QJAlΩjMѻP᪺AJ
+// uniformPzipfGH
+// adversarialGu줸PAuϥΧC줸(ҦpưtX2)|bP@ӱ
+template <class Key>
+std::vector<Key> make_keys(std::size_t count, distribution dist) {
+    std::vector<Key> keys;
+    keys.reserve(count);
+    constexpr bool narrow = std::is_same_v<Key, std::uint32_t>;
+    int shift = (narrow ? 32 : 64) - std::bit_width(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        std::uint64_t id;
+        if (dist == distribution::adversarial) {
+            id = std::uint64_t(i) << shift;
+        }
+        else if constexpr (narrow) {
+            id = fmix32(static_cast<std::uint32_t>(i));
+        }
+        else {
+            id = splitmix64(i);
+        }
+        keys.push_back(make_key<Key>(id));
+    }
+    return keys;
+}
+
+// HYCSBkZipfƦWAs = 0.99
+class zipf_generator {
+    std::size_t n;
+    double theta, alpha, zetan, eta;
+    static double zeta(std::size_t n, double theta) {
+        double sum = 0;
+        for (std::size_t i = 1; i <= n; ++i) {
+            sum += 1.0 / std::pow(double(i), theta);
+        }
+        return sum;
+    }
+public:
+    zipf_generator(std::size_t count, double s = 0.99)
+        : n(count), theta(s), alpha(1.0 / (1.0 - s)), zetan(zeta(count, s)) {
+        eta = (1.0 - std::pow(2.0 / double(n), 1.0 - theta)) / (1.0 - zeta(2, theta) / zetan);
+    }
+    template <class Rng>
+    std::size_t operator()(Rng& rng) {
+        double u = std::uniform_real_distribution<double>(0.0, 1.0)(rng);
+        double uz = u * zetan;
+        if (uz < 1.0) {
+            return 0;
+        }
+        if (uz < 1.0 + std::pow(0.5, theta)) {
+            return 1;
+        }
+        return (std::min)(n - 1, static_cast<std::size_t>(double(n) * std::pow(eta * u - eta + 1.0, alpha)));
+    }
+};
+
+// jMǡGuniformPadversarialÿAzipfZipf(ƦWgLA䤣|bJǪeq)
+std::vector<std::uint32_t> make_queries(std::size_t n, std::size_t count, distribution dist) {
+    std::vector<std::uint32_t> queries(count);
+    std::mt19937_64 rng(12345);
+    if (dist == distribution::zipf) {
+        zipf_generator zipf(n);
+        for (auto& q : queries) {
+            q = static_cast<std::uint32_t>(splitmix64(zipf(rng)) % n);
+        }
+    }
+    else {
+        std::uniform_int_distribution<std::size_t> pick(0, n - 1);
+        for (auto& q : queries) {
+            q = static_cast<std::uint32_t>(pick(rng));
+        }
+    }
+    return queries;
+}
+
+using clock_type = std::chrono::steady_clock;
+inline double seconds_since(clock_type::time_point start) {
+    return std::chrono::duration<double>(clock_type::now() - start).count();
+}
+// קKQ̨ΤƱG
+std::atomic<std::size_t> sink{ 0 };
+
+struct result {
+    const char* container;
+    const char* key;
+    const char* dist;
+    std::size_t size;
+    const char* op;
+    std::size_t ops = 0;
+    double seconds = 0;
+    std::vector<float> latencies{};  // Cާ@(`)Ai
+    std::size_t bytes = 0;         // ާ@eΪ줸
+    std::size_t peak_bytes = 0;    // ާ@̤jtmq
+    unsigned threads = 1;
+    void print() {
+        std::printf("{\"container\":\"%s\",\"key\":\"%s\",\"dist\":\"%s\",\"size\":%zu,\"op\":\"%s\",\"threads\":%u,"
+            "\"ops\":%zu,\"ns_per_op\":%.2f,\"mops\":%.3f",
+            container, key, dist, size, op, threads, ops, seconds * 1e9 / double(ops), double(ops) / seconds / 1e6);
+        if (!latencies.empty()) {
+            std::sort(latencies.begin(), latencies.end());
+            auto at = [&](double q) {
+                return latencies[(std::min)(latencies.size() - 1, static_cast<std::size_t>(q * double(latencies.size())))];
+            };
+            std::printf(",\"p50_ns\":%.0f,\"p99_ns\":%.0f,\"p999_ns\":%.0f,\"max_ns\":%.0f",
+                at(0.5), at(0.99), at(0.999), latencies.back());
+        }
+        if (bytes || peak_bytes) {
+            std::printf(",\"bytes\":%zu,\"peak_bytes\":%zu", bytes, peak_bytes);
+        }
+        std::printf("}\n");
+        std::fflush(stdout);
+    }
+};
+
+// 1B2B4KKwơAwƤO2ɳ̫A[W
+std::vector<unsigned> default_threads() {
+    unsigned hardware = (std::max)(1u, std::thread::hardware_concurrency());
+    std::vector<unsigned> result;
+    for (unsigned t = 1; t < hardware; t *= 2) {
+        result.push_back(t);
+    }
+    result.push_back(hardware);
+    return result;
+}
+
+struct options {
+    std::vector<std::size_t> sizes{ std::size_t(1) << 10, std::size_t(1) << 14, std::size_t(1) << 18, std::size_t(1) << 22 };
+    std::vector<std::string> keys{ "int", "u64", "string", "struct" };
+    std::vector<std::string> dists{ "uniform", "zipf", "adversarial" };
+    std::vector<std::string> containers{ "sbh", "sbh_fastmod", "sbh_incremental", "sbh_huge_pages", "std", "open_addressing" };
+    std::vector<std::string> ops{ "insert", "find_hit", "find_miss", "find_hit_batched", "erase_churn", "erase_half", "merge", "iterate",
+        "rehash", "copy", "concurrent_insert", "concurrent_find", "find_under_writes" };
+    std::vector<unsigned> threads = default_threads();  // hժƶq
+    std::size_t target_ops = std::size_t(1) << 22;      // Cզܤְ檺ާ@
+    std::size_t latency_samples = std::size_t(1) << 20;  // ˼ƶqW
+    [[nodiscard]] bool has(const std::vector<std::string>& list, std::string_view name) const {
+        return std::find(list.begin(), list.end(), name) != list.end();
+    }
+};
+
+// @eB䫬OBPjpҦ
+template <class Set, class Key>
+struct runner {
+    const options& opt;
+    const char* container;
+    const char* key_name;
+    distribution dist;
+    std::size_t n;
+    const std::vector<Key>& keys;                 // [0, n)JA[n, 2n)sb
+    const std::vector<std::uint32_t>& queries;
+
+    result make_result(const char* op) const {
+        return result{ container, key_name, to_string(dist), n, op };
+    }
+    Set build() const {
+        Set set;
+        for (std::size_t i = 0; i < n; ++i) {
+            set.insert(keys[i]);
+        }
+        return set;
+    }
+    std::size_t repeats(std::size_t ops_per_round) const {
+        return (std::max)(std::size_t(1), opt.target_ops / (std::max)(ops_per_round, std::size_t(1)));
+    }
+    void run() const {
+        if (opt.has(opt.ops, "insert")) {
+            insert();
+        }
+        Set set = build();
+        if (opt.has(opt.ops, "find_hit")) {
+            find(set, "find_hit", 0);
+        }
+        if (opt.has(opt.ops, "find_miss")) {
+            find(set, "find_miss", n);
+        }
+        if constexpr (requires(const Set & s, const Key * k, bool* out) { s.contains_many(k, k, out); }) {
+            if (opt.has(opt.ops, "find_hit_batched")) {
+                find_batched(set);
+            }
+        }
+        if (opt.has(opt.ops, "iterate")) {
+            iterate(set);
+        }
+        if (opt.has(opt.ops, "copy")) {
+            copy(set);
+        }
+        if (opt.has(opt.ops, "rehash")) {
+            rehash();
+        }
+        if (opt.has(opt.ops, "erase_half")) {
+            erase_half();
+        }
+        if (opt.has(opt.ops, "merge")) {
+            merge();
+        }
+        if (opt.has(opt.ops, "erase_churn")) {
+            erase_churn(std::move(set));
+        }
+    }
+    void insert() const {
+        result r = make_result("insert");
+        std::size_t rounds = repeats(n);
+        std::size_t before = memory::current.load();
+        memory::reset_peak();
+        {
+            auto start = clock_type::now();
+            Set set = build();
+            r.seconds += seconds_since(start);
+            r.bytes = memory::current.load() - before;
+            r.peak_bytes = memory::peak.load() - before;
+            sink += set.size();
+        }
+        for (std::size_t round = 1; round < rounds; ++round) {
+            auto start = clock_type::now();
+            Set set = build();
+            r.seconds += seconds_since(start);
+            sink += set.size();
+        }
+        r.ops = rounds * n;
+        // t~غc@óv@pɡAHo(]trehashyy)
+        {
+            Set set;
+            std::size_t samples = (std::min)(n, opt.latency_samples);
+            r.latencies.reserve(samples);
+            for (std::size_t i = 0; i < n; ++i) {
+                if (i < samples) {
+                    auto start = clock_type::now();
+                    set.insert(keys[i]);
+                    r.latencies.push_back(std::chrono::duration<float, std::nano>(clock_type::now() - start).count());
+                }
+                else {
+                    set.insert(keys[i]);
+                }
+            }
+        }
+        r.print();
+    }
+    void find(const Set& set, const char* op, std::size_t offset) const {
+        result r = make_result(op);
+        std::size_t rounds = repeats(queries.size());
+        std::size_t found = 0;
+        auto start = clock_type::now();
+        for (std::size_t round = 0; round < rounds; ++round) {
+            for (auto q : queries) {
+                found += set.find(keys[offset + q]) != set.end();
+            }
+        }
+        r.seconds = seconds_since(start);
+        r.ops = rounds * queries.size();
+        std::size_t samples = (std::min)(queries.size(), opt.latency_samples);
+        r.latencies.reserve(samples);
+        for (std::size_t i = 0; i < samples; ++i) {
+            auto t = clock_type::now();
+            found += set.find(keys[offset + queries[i]]) != set.end();
+            r.latencies.push_back(std::chrono::duration<float, std::nano>(clock_type::now() - t).count());
+        }
+        sink += found;
+        r.print();
+    }
+    void find_batched(const Set& set) const {
+        result r = make_result("find_hit_batched");
+        std::vector<Key> lookup;
+        lookup.reserve(queries.size());
+        for (auto q : queries) {
+            lookup.push_back(keys[q]);
+        }
+        std::vector<char> out(lookup.size());
+        std::size_t rounds = repeats(lookup.size());
+        auto start = clock_type::now();
+        for (std::size_t round = 0; round < rounds; ++round) {
+            set.contains_many(lookup.begin(), lookup.end(), out.begin());
+            sink += static_cast<std::size_t>(out[round % out.size()]);
+        }
+        r.seconds = seconds_since(start);
+        r.ops = rounds * lookup.size();
+        r.print();
+    }
+    void iterate(const Set& set) const {
+        result r = make_result("iterate");
+        std::size_t rounds = repeats(set.size());
+        std::size_t total = 0;
+        auto start = clock_type::now();
+        for (std::size_t round = 0; round < rounds; ++round) {
+            for (const auto& key : set) {
+                if constexpr (std::is_same_v<Key, std::string>) {
+                    total += key.size();
+                }
+                else if constexpr (std::is_same_v<Key, large_key>) {
+                    total += key.id;
+                }
+                else {
+                    total += static_cast<std::size_t>(key);
+                }
+            }
+        }
+        r.seconds = seconds_since(start);
+        r.ops = rounds * set.size();
+        sink += total;
+        r.print();
+    }
+    void copy(const Set& set) const {
+        result r = make_result("copy");
+        std::size_t rounds = (std::max)(std::size_t(1), repeats(n) / 4);
+        std::size_t before = memory::current.load();
+        memory::reset_peak();
+        for (std::size_t round = 0; round < rounds; ++round) {
+            auto start = clock_type::now();
+            Set copied(set);
+            r.seconds += seconds_since(start);
+            r.bytes = memory::current.load() - before;
+            sink += copied.size();
+        }
+        r.peak_bytes = memory::peak.load() - before;
+        r.ops = rounds * n;
+        r.print();
+    }
+    // wغcerehash⭿
+    void rehash() const {
+        result r = make_result("rehash");
+        std::size_t rounds = (std::max)(std::size_t(1), repeats(n) / 4);
+        for (std::size_t round = 0; round < rounds; ++round) {
+            Set set = build();
+            auto nbuckets = set.bucket_count() * 2;
+            auto start = clock_type::now();
+            set.rehash(static_cast<decltype(nbuckets)>(nbuckets));
+            r.seconds += seconds_since(start);
+            sink += set.bucket_count();
+        }
+        r.ops = rounds * n;
+        r.print();
+    }
+    // qغce@b(queries)A䴩erase_manyet~դ@妸
+    void erase_half() const {
+        std::vector<Key> victims;
+        victims.reserve(n / 2);
+        std::vector<bool> chosen(n, false);
+        for (std::size_t i = 0; i < queries.size() && victims.size() < n / 2; ++i) {
+            if (!chosen[queries[i]]) {
+                chosen[queries[i]] = true;
+                victims.push_back(keys[queries[i]]);
+            }
+        }
+        for (std::size_t i = 0; victims.size() < n / 2; ++i) {
+            if (!chosen[i]) {
+                victims.push_back(keys[i]);
+            }
+        }
+        std::size_t rounds = (std::max)(std::size_t(1), repeats(n) / 4);
+        result r = make_result("erase_half");
+        for (std::size_t round = 0; round < rounds; ++round) {
+            Set set = build();
+            auto start = clock_type::now();
+            for (const Key& key : victims) {
+                set.erase(key);
+            }
+            r.seconds += seconds_since(start);
+            sink += set.size();
+        }
+        r.ops = rounds * victims.size();
+        r.print();
+        if constexpr (requires(Set & s) { s.erase_many(victims.begin(), victims.end()); }) {
+            result bulk = make_result("erase_half_bulk");
+            for (std::size_t round = 0; round < rounds; ++round) {
+                Set set = build();
+                auto start = clock_type::now();
+                set.erase_many(victims.begin(), victims.end());
+                bulk.seconds += seconds_since(start);
+                sink += set.size();
+            }
+            bulk.ops = rounds * victims.size();
+            bulk.print();
+        }
+    }
+    // t[n/2, 3n/2)e֤Jt[0, n)eA@b䭫
+    // 䴩mergeeϥmergeA_hv@JFt~Hmerge_loopOv@Jɶ@
+    void merge() const {
+        auto build_other = [&] {
+            Set other;
+            for (std::size_t i = n / 2; i < n + n / 2; ++i) {
+                other.insert(keys[i]);
+            }
+            return other;
+        };
+        std::size_t rounds = (std::max)(std::size_t(1), repeats(n) / 4);
+        result r = make_result("merge");
+        result loop = make_result("merge_loop");
+        for (std::size_t round = 0; round < rounds; ++round) {
+            Set set = build();
+            Set other = build_other();
+            auto start = clock_type::now();
+            if constexpr (requires(Set & s) { s.merge(other); }) {
+                set.merge(other);
+            }
+            else {
+                for (const auto& key : other) {
+                    set.insert(key);
+                }
+            }
+            r.seconds += seconds_since(start);
+            sink += set.size() + other.size();
+            set = build();
+            other = build_other();
+            start = clock_type::now();
+            for (const auto& key : other) {
+                set.insert(key);
+            }
+            loop.seconds += seconds_since(start);
+            sink += set.size();
+        }
+        r.ops = loop.ops = rounds * n;
+        r.print();
+        loop.print();
+    }
+    // @ӦsbôJ@ӤsbAejp
+    void erase_churn(Set set) const {
+        result r = make_result("erase_churn");
+        std::vector<std::uint32_t> live(n), spare(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            live[i] = static_cast<std::uint32_t>(i);
+            spare[i] = static_cast<std::uint32_t>(n + i);
+        }
+        std::size_t steps = (std::max)(n, opt.target_ops / 2);
+        auto start = clock_type::now();
+        for (std::size_t step = 0; step < steps; ++step) {
+            std::size_t slot = queries[step % queries.size()];
+            set.erase(keys[live[slot]]);
+            set.insert(keys[spare[slot]]);
+            std::swap(live[slot], spare[slot]);
+        }
+        r.seconds = seconds_since(start);
+        r.ops = steps * 2;
+        sink += set.size();
+        r.print();
+    }
+};
+
+// hJPjMGconcurrent_single_buffer_hash_setWHstd::shared_mutexO@std::unordered_set
+template <class Key>
+struct locked_unordered_set {
+    std::unordered_set<Key> set;
+    mutable std::shared_mutex mutex;
+    bool insert(const Key& key) {
+        std::unique_lock lock(mutex);
+        return set.insert(key).second;
+    }
+    bool contains(const Key& key) const {
+        std::shared_lock lock(mutex);
+        return set.count(key) != 0;
+    }
+    std::size_t erase(const Key& key) {
+        std::unique_lock lock(mutex);
+        return set.erase(key);
+    }
+};
+template <class Set, class Key>
+void run_concurrent(const options& opt, const char* container, const char* key_name, distribution dist,
+    std::size_t n, const std::vector<Key>& keys, const std::vector<std::uint32_t>& queries) {
+    for (unsigned threads : opt.threads) {
+        auto parallel = [&](auto&& f) {
+            std::vector<std::thread> pool;
+            for (unsigned t = 1; t < threads; ++t) {
+                pool.emplace_back(f, t);
+            }
+            f(0u);
+            for (auto& thread : pool) {
+                thread.join();
+            }
+        };
+        Set set;
+        if (opt.has(opt.ops, "concurrent_insert")) {
+            result r{ container, key_name, to_string(dist), n, "concurrent_insert" };
+            r.threads = threads;
+            auto start = clock_type::now();
+            parallel([&](unsigned t) {
+                for (std::size_t i = t; i < n; i += threads) {
+                    set.insert(keys[i]);
+                }
+            });
+            r.seconds = seconds_since(start);
+            r.ops = n;
+            r.print();
+        }
+        else {
+            for (std::size_t i = 0; i < n; ++i) {
+                set.insert(keys[i]);
+            }
+        }
+        if (opt.has(opt.ops, "concurrent_find")) {
+            result r{ container, key_name, to_string(dist), n, "concurrent_find" };
+            r.threads = threads;
+            std::size_t rounds = (std::max)(std::size_t(1), opt.target_ops / queries.size());
+            auto start = clock_type::now();
+            parallel([&](unsigned t) {
+                std::size_t found = 0;
+                for (std::size_t round = 0; round < rounds; ++round) {
+                    for (std::size_t i = t; i < queries.size(); i += threads) {
+                        found += set.contains(keys[queries[i]]);
+                    }
+                }
+                sink += found;
+            });
+            r.seconds = seconds_since(start);
+            r.ops = rounds * queries.size();
+            r.print();
+        }
+    }
+}
+
+// @ӼgJ̤_ísJ[n, 2n)AlPɷjM[0, n)AupŪ̪ާ@
+// snapshot_single_buffer_hash_setC64קo@AŲ̄CBz@dߴNso̷s
+// t~X@gJ̪]Rq(opfind_under_writes/writer)AiHݥXoPƻs϶
+// Ū̪ƶq--threads=CӭȦUդ@AgJ̤pJ
+template <class Set, class Key>
+void run_find_under_writes(const options& opt, const char* container, const char* key_name, distribution dist,
+    std::size_t n, const std::vector<Key>& keys, const std::vector<std::uint32_t>& queries) {
+    constexpr bool is_snapshot = requires(Set& set) { set.publish(); };
+    constexpr std::size_t batch = 256;
+    constexpr std::size_t publish_interval = 64;
+    for (unsigned readers : opt.threads) {
+        Set set;
+        for (std::size_t i = 0; i < n; ++i) {
+            set.insert(keys[i]);
+        }
+        if constexpr (is_snapshot) {
+            set.publish();
+        }
+        std::size_t rounds = (std::max)(std::size_t(1), opt.target_ops / queries.size());
+        std::atomic<bool> done{ false };
+        std::atomic<unsigned> running{ readers };
+        std::size_t writes = 0;
+        std::thread writer([&] {
+            std::size_t step = 0;
+            while (!done.load(std::memory_order_relaxed)) {
+                const Key& key = keys[n + step % n];
+                if ((step / n) % 2 == 0) {
+                    set.insert(key);
+                }
+                else {
+                    set.erase(key);
+                }
+                ++step;
+                if constexpr (is_snapshot) {
+                    if (step % publish_interval == 0) {
+                        set.publish();
+                    }
+                }
+            }
+            writes = step;
+        });
+        result r{ container, key_name, to_string(dist), n, "find_under_writes" };
+        r.threads = readers;
+        auto start = clock_type::now();
+        std::vector<std::thread> pool;
+        for (unsigned t = 0; t < readers; ++t) {
+            pool.emplace_back([&, t] {
+                std::size_t found = 0;
+                for (std::size_t round = 0; round < rounds; ++round) {
+                    for (std::size_t first = t * batch; first < queries.size(); first += std::size_t(readers) * batch) {
+                        std::size_t last = (std::min)(first + batch, queries.size());
+                        if constexpr (is_snapshot) {
+                            auto snapshot = set.acquire();
+                            for (std::size_t i = first; i < last; ++i) {
+                                found += snapshot.contains(keys[queries[i]]);
+                            }
+                        }
+                        else {
+                            for (std::size_t i = first; i < last; ++i) {
+                                found += set.contains(keys[queries[i]]);
+                            }
+                        }
+                    }
+                }
+                sink += found;
+                if (--running == 0) {
+                    done = true;
+                }
+            });
+        }
+        for (auto& thread : pool) {
+            thread.join();
+        }
+        r.seconds = seconds_since(start);
+        writer.join();
+        r.ops = rounds * queries.size();
+        r.print();
+        result w{ container, key_name, to_string(dist), n, "find_under_writes/writer" };
+        w.seconds = r.seconds;
+        w.ops = (std::max)(writes, std::size_t(1));
+        w.print();
+    }
+}
+
+template <class Key>
+void run_key(const options& opt, const char* key_name) {
+    for (const auto& dist_name : opt.dists) {
+        distribution dist = dist_name == "zipf" ? distribution::zipf :
+            dist_name == "adversarial" ? distribution::adversarial : distribution::uniform;
+        for (std::size_t n : opt.sizes) {
+            std::vector<Key> keys = make_keys<Key>(2 * n, dist);
+            std::vector<std::uint32_t> queries = make_queries(n, (std::min)(opt.target_ops, (std::max)(n, std::size_t(1) << 16)), dist);
+            if (opt.has(opt.containers, "sbh")) {
+                runner<single_buffer_hash_set<Key>, Key>{ opt, "single_buffer_hash_set", key_name, dist, n, keys, queries }.run();
+            }
+            if (opt.has(opt.containers, "sbh_fastmod")) {
+                using set_type = single_buffer_hash_set<Key, std::hash<Key>, std::equal_to<Key>, std::allocator<Key>,
+                    true, sbh_default_store_hash<std::hash<Key>>, sbh_prime_fastmod>;
+                runner<set_type, Key>{ opt, "single_buffer_hash_set/fastmod", key_name, dist, n, keys, queries }.run();
+            }
+            if (opt.has(opt.containers, "sbh_incremental")) {
+                using set_type = single_buffer_hash_set<Key, std::hash<Key>, std::equal_to<Key>, std::allocator<Key>,
+                    true, sbh_default_store_hash<std::hash<Key>>, sbh_prime_modulo, false, true>;
+                runner<set_type, Key>{ opt, "single_buffer_hash_set/incremental", key_name, dist, n, keys, queries }.run();
+            }
+            if (opt.has(opt.containers, "sbh_huge_pages")) {
+                using set_type = single_buffer_hash_set<Key, std::hash<Key>, std::equal_to<Key>, sbh_huge_page_allocator<Key>>;
+                runner<set_type, Key>{ opt, "single_buffer_hash_set/huge_pages", key_name, dist, n, keys, queries }.run();
+            }
+            if (opt.has(opt.containers, "std")) {
+                runner<std::unordered_set<Key>, Key>{ opt, "std::unordered_set", key_name, dist, n, keys, queries }.run();
+            }
+            if (opt.has(opt.containers, "open_addressing")) {
+                runner<open_addressing_set<Key>, Key>{ opt, "open_addressing", key_name, dist, n, keys, queries }.run();
+            }
+            if (opt.has(opt.containers, "sbh")) {
+                run_concurrent<concurrent_single_buffer_hash_set<Key>, Key>(opt, "concurrent_single_buffer_hash_set", key_name, dist, n, keys, queries);
+            }
+            if (opt.has(opt.containers, "std")) {
+                run_concurrent<locked_unordered_set<Key>, Key>(opt, "std::unordered_set+shared_mutex", key_name, dist, n, keys, queries);
+            }
+            if (opt.has(opt.ops, "find_under_writes")) {
+                if (opt.has(opt.containers, "sbh")) {
+                    run_find_under_writes<snapshot_single_buffer_hash_set<Key>, Key>(opt, "snapshot_single_buffer_hash_set", key_name, dist, n, keys, queries);
+                    run_find_under_writes<concurrent_single_buffer_hash_set<Key>, Key>(opt, "concurrent_single_buffer_hash_set", key_name, dist, n, keys, queries);
+                }
+                if (opt.has(opt.containers, "std")) {
+                    run_find_under_writes<locked_unordered_set<Key>, Key>(opt, "std::unordered_set+shared_mutex", key_name, dist, n, keys, queries);
+                }
+            }
+        }
+    }
+}
+
+std::vector<std::string> split(std::string_view list) {
+    std::vector<std::string> result;
+    while (!list.empty()) {
+        std::size_t comma = list.find(',');
+        result.emplace_back(list.substr(0, comma));
+        list = comma == std::string_view::npos ? std::string_view() : list.substr(comma + 1);
+    }
+    return result;
+}
+
+int main(int argc, char** argv) {
+    options opt;
+    for (int i = 1; i < argc; ++i) {
+        std::string_view arg = argv[i];
+        auto value = [&](std::string_view name) -> std::string_view {
+            return arg.substr(name.size());
+        };
+        if (arg == "--quick") {
+            opt.sizes = { std::size_t(1) << 10, std::size_t(1) << 16 };
+            opt.target_ops = std::size_t(1) << 18;
+            opt.latency_samples = std::size_t(1) << 16;
+        }
+        else if (arg.starts_with("--sizes=")) {
+            opt.sizes.clear();
+            for (auto& size : split(value("--sizes="))) {
+                opt.sizes.push_back(std::strtoull(size.c_str(), nullptr, 10));
+            }
+        }
+        else if (arg.starts_with("--keys=")) {
+            opt.keys = split(value("--keys="));
+        }
+        else if (arg.starts_with("--dists=")) {
+            opt.dists = split(value("--dists="));
+        }
+        else if (arg.starts_with("--containers=")) {
+            opt.containers = split(value("--containers="));
+        }
+        else if (arg.starts_with("--ops=")) {
+            opt.ops = split(value("--ops="));
+        }
+        else if (arg.starts_with("--threads=")) {
+            opt.threads.clear();
+            for (auto& count : split(value("--threads="))) {
+                opt.threads.push_back((std::max)(1u, static_cast<unsigned>(std::strtoul(count.c_str(), nullptr, 10))));
+            }
+        }
+        else if (arg.starts_with("--target-ops=")) {
+            opt.target_ops = std::strtoull(std::string(value("--target-ops=")).c_str(), nullptr, 10);
+        }
+        else {
+            std::fprintf(stderr, "unknown option: %s\n", argv[i]);
+            return 1;
+        }
+    }
+    if (opt.has(opt.keys, "int")) {
+        run_key<std::uint32_t>(opt, "int");
+    }
+    if (opt.has(opt.keys, "u64")) {
+        run_key<std::uint64_t>(opt, "u64");
+    }
+    if (opt.has(opt.keys, "string")) {
+        run_key<std::string>(opt, "string");
+    }
+    if (opt.has(opt.keys, "struct")) {
+        run_key<large_key>(opt, "struct");
+    }
+    return sink.load() == 42 ? 2 : 0;
+}
\ No newline at end of file
@@ -0,0 +1,161 @@
+#pragma once
+#ifndef CONCURRENT_SINGLE_BUFFER_HASH_SET
+#define CONCURRENT_SINGLE_BUFFER_HASH_SET
+#include "single_buffer_hash_set.h"
+#include <climits>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#if _HAS_CXX20 || __cplusplus >= 202002L
+// HƭȪ줸N2^ShardBitsӤۿWߪsingle_buffer_hash_set
+// CӤU۾֦@ŪgAPWާ@iH
+// P@WjMuݭn@AuJPݭnWe
+template <
+    class Key,
+    class Hash = std::hash<Key>,
+    class Pred = std::equal_to<Key>,
+    std::size_t ShardBits = 6>
+class concurrent_single_buffer_hash_set {
+public:
+    using shard_type = single_buffer_hash_set<Key, Hash, Pred>;
+    using value_type = Key;
+    using key_type = Key;
+    using size_type = std::size_t;
+    using hasher = Hash;
+    using key_equal = Pred;
+    static constexpr size_type shard_count = size_type(1) << ShardBits;
+    static_assert(ShardBits < sizeof(std::size_t) * CHAR_BIT, "too many shards");
+private:
+    // ܧ֨CAקK۾F겣Ͱ@
+    struct alignas(64) Shard {
+        mutable std::shared_mutex mutex;
+        shard_type set;
+    };
+    std::unique_ptr<Shard[]> shards;
+    [[no_unique_address]] [[msvc::no_unique_address]] hasher hash; // ƨ
+public:
+    // غc禡
+    // bucket_countPinitialCapacity|tUӤ
+    // bucket_count0ɦU]tmA֮ɺpҦ
+    explicit concurrent_single_buffer_hash_set(size_type bucket_count = 0, size_type initialCapacity = 0, const hasher& hashFunction = hasher(), const key_equal& equalFunction = key_equal())
+        : shards(new Shard[shard_count]), hash(hashFunction) {
+        for (size_type i = 0; i < shard_count; ++i) {
+            shards[i].set = shard_type(
+                static_cast<typename shard_type::size_type>(bucket_count / shard_count),
+                static_cast<typename shard_type::size_type>(initialCapacity / shard_count),
+                hashFunction, equalFunction);
+        }
+    }
+    concurrent_single_buffer_hash_set(const concurrent_single_buffer_hash_set&) = delete;
+    concurrent_single_buffer_hash_set& operator=(const concurrent_single_buffer_hash_set&) = delete;
+    // ʾާ@OwAIsɤoLs@
+    // Qʫ᪺uQPγQ
+    concurrent_single_buffer_hash_set(concurrent_single_buffer_hash_set&&) noexcept = default;
+    concurrent_single_buffer_hash_set& operator=(concurrent_single_buffer_hash_set&&) noexcept = default;
+
+    // HUҦ禡Ҭw
+    // ƭȥup@AboꤧeΨӿܤAAHwp⪺ƭȶǵ
+    bool insert(const value_type& value) {
+        std::size_t hash_code = hash(value);
+        Shard& shard = shards[_shard_index(hash_code)];
+        std::unique_lock lock(shard.mutex);
+        return shard.set._index_insert(value, hash_code).second;
+    }
+    bool insert(value_type&& value) {
+        std::size_t hash_code = hash(value);
+        Shard& shard = shards[_shard_index(hash_code)];
+        std::unique_lock lock(shard.mutex);
+        return shard.set._index_insert(std::move(value), hash_code).second;
+    }
+    // boꤧeغcAHYuꪺɶ
+    template <class... Args>
+    bool emplace(Args&&... args) {
+        return insert(value_type(std::forward<Args>(args)...));
+    }
+    [[nodiscard]] bool contains(const key_type& key) const {
+        std::size_t hash_code = hash(key);
+        const Shard& shard = shards[_shard_index(hash_code)];
+        std::shared_lock lock(shard.mutex);
+        return shard.set.contains(key, hash_code);
+    }
+    [[nodiscard]] size_type count(const key_type& key) const {
+        return contains(key);
+    }
+    size_type erase(const key_type& key) {
+        std::size_t hash_code = hash(key);
+        Shard& shard = shards[_shard_index(hash_code)];
+        std::unique_lock lock(shard.mutex);
+        return shard.set.erase(key, hash_code);
+    }
+    // pGkeyAhb@ꪺpUHconstѦҩIsfA^ǬO_
+    // fosP@ӮeA_hiy
+    template <class F>
+    bool visit(const key_type& key, F&& f) const {
+        std::size_t hash_code = hash(key);
+        const Shard& shard = shards[_shard_index(hash_code)];
+        std::shared_lock lock(shard.mutex);
+        auto where = shard.set._index_find(key, hash_code);
+        if (where == shard_type::npos) {
+            return false;
+        }
+        std::forward<F>(f)(shard.set.begin()[where]);
+        return true;
+    }
+    // ̧ǹCӤo@AåHCӤconstѦҩIsf
+    // uOҨCӤU۪@PʡAOҾӮeַӤ@P
+    template <class F>
+    void for_each(F f) const {
+        for (size_type i = 0; i < shard_count; ++i) {
+            std::shared_lock lock(shards[i].mutex);
+            for (const auto& value : shards[i].set) {
+                f(value);
+            }
+        }
+    }
+    // bLPɭקɡA^ǭȶȬ
+    [[nodiscard]] size_type size() const {
+        size_type result = 0;
+        for (size_type i = 0; i < shard_count; ++i) {
+            std::shared_lock lock(shards[i].mutex);
+            result += shards[i].set.size();
+        }
+        return result;
+    }
+    [[nodiscard]] bool empty() const {
+        return size() == 0;
+    }
+    void clear() {
+        for (size_type i = 0; i < shard_count; ++i) {
+            std::unique_lock lock(shards[i].mutex);
+            shards[i].set.clear();
+        }
+    }
+    void reserve(size_type newcapacity) {
+        for (size_type i = 0; i < shard_count; ++i) {
+            std::unique_lock lock(shards[i].mutex);
+            shards[i].set.reserve(static_cast<typename shard_type::size_type>(newcapacity / shard_count + 1));
+        }
+    }
+    [[nodiscard]] hasher hash_function() const noexcept(noexcept(hasher(hash))) {
+        return hash;
+    }
+private:
+    // HkVX᪺̰ShardBits줸ܤAϫƨƤ]७
+    // P@uOoǦ줸ۦPFϥιw]sbh_prime_moduloAިM󫢧ƭȪҦ줸A]vT
+    // YΥuݲVXᰪ줸(ҦpP˭Wұ`ƪsbh_fastrange)AP@|bּƪ
+    [[nodiscard]] static constexpr size_type _shard_index(std::size_t hash_code) noexcept {
+        if constexpr (ShardBits == 0) {
+            return 0;
+        }
+        else if constexpr (sizeof(std::size_t) > sizeof(std::uint32_t)) {
+            return static_cast<size_type>((hash_code * 0x9E3779B97F4A7C15) >> (64 - ShardBits));
+        }
+        else {
+            return static_cast<size_type>((hash_code * 0x9E3779B9u) >> (32 - ShardBits));
+        }
+    }
+};
+#else
+#error C++20 or later required
+#endif // _HAS_CXX20
+#endif // CONCURRENT_SINGLE_BUFFER_HASH_SET
\ No newline at end of file
@@ -0,0 +1,691 @@
+#pragma once
+#ifndef FROZEN_SINGLE_BUFFER_HASH_SET
+#define FROZEN_SINGLE_BUFFER_HASH_SET
+#include "single_buffer_hash_set.h"
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+#if _HAS_CXX20 || __cplusplus >= 202002L
+// Nsingle_buffer_hash_setgJɮסAåHOMgŪJAݭnϧǦC
+//
+// ɮ׮榡(1)AҦƭȬҬgJݪͦ줸նǡG
+//   sbh_file_header
+//   keys     }CCiZƻs䪽gJFrhgJsbh_string_ref{offset, length}
+//   next     index}CAPsingle_buffer_hash_setNode::nextۦP
+//   hashes   StoreHashɼgJstd::size_tƭȰ}CA_h׬0
+//   buckets  index}CAPsingle_buffer_hash_setbucketsۦP
+//   pool     rꤺeAȥΩr
+// CӰϬq_I_section_alignment
+// ƭȻPިMHash@A]ɮץuѨϥάۦPHashPBucketPolicy{J
+
+// CӤر޵bɮפsA0ܤ䴩ǦC
+template <class BucketPolicy>
+inline constexpr std::uint32_t sbh_bucket_policy_id = 0;
+template <>
+inline constexpr std::uint32_t sbh_bucket_policy_id<sbh_prime_modulo> = 1;
+template <>
+inline constexpr std::uint32_t sbh_bucket_policy_id<sbh_power_of_two> = 2;
+template <>
+inline constexpr std::uint32_t sbh_bucket_policy_id<sbh_fastrange> = 3;
+template <>
+inline constexpr std::uint32_t sbh_bucket_policy_id<sbh_prime_fastmod> = 4;
+
+// r@ӦrꪺmAHr
+struct sbh_string_ref {
+    std::uint64_t offset;
+    std::uint64_t length;
+};
+
+// bɮפܤ覡
+// iZƻs䪽gJFstd::basic_stringgJrAjMɥHstd::basic_string_view
+template <class Key>
+struct sbh_frozen_key_traits {
+    static constexpr bool is_string = false;
+    using stored_type = Key;
+    using value_type = Key;
+    using view_type = const Key&;
+    using char_type = char;
+};
+template <class CharT, class Traits, class Alloc>
+struct sbh_frozen_key_traits<std::basic_string<CharT, Traits, Alloc>> {
+    static constexpr bool is_string = true;
+    using stored_type = sbh_string_ref;
+    using value_type = std::basic_string_view<CharT, Traits>;
+    using view_type = value_type;
+    using char_type = CharT;
+};
+
+struct sbh_file_header {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t endian;         // gJ0x01020304AΨӰ줸նǤPx
+    std::uint32_t bucket_policy;  // sbh_bucket_policy_id
+    std::uint32_t key_layout;     // 0GgJA1Gr
+    std::uint32_t key_size;       // Φrjp
+    std::uint32_t index_size;
+    std::uint32_t hash_size;      // xsƭȮɬsizeof(std::size_t)A_h0
+    std::uint32_t reserved;
+    std::uint64_t size;
+    std::uint64_t bucket_count;
+    std::uint64_t keys_offset;
+    std::uint64_t next_offset;
+    std::uint64_t hashes_offset;
+    std::uint64_t buckets_offset;
+    std::uint64_t pool_offset;
+    std::uint64_t pool_size;
+    static constexpr char expected_magic[8] = { 'S', 'B', 'H', 'S', 'E', 'T', '\r', '\n' };
+    static constexpr std::uint32_t current_version = 1;
+    static constexpr std::uint32_t native_endian = 0x01020304;
+};
+static_assert(std::is_trivially_copyable_v<sbh_file_header>);
+
+struct sbh_serialization {
+    static constexpr std::uint64_t _section_alignment = 64;
+    [[nodiscard]] static constexpr std::uint64_t _align(std::uint64_t offset) noexcept {
+        return (offset + _section_alignment - 1) / _section_alignment * _section_alignment;
+    }
+    template <class T>
+    static void _write(std::ostream& out, const T* data, std::size_t count) {
+        out.write(reinterpret_cast<const char*>(data), static_cast<std::streamsize>(sizeof(T) * count));
+    }
+    static void _pad(std::ostream& out, std::uint64_t& position, std::uint64_t target) {
+        static constexpr char zeros[_section_alignment] = {};
+        out.write(zeros, static_cast<std::streamsize>(target - position));
+        position = target;
+    }
+    template <class Key, class Hash, class Pred, class Allocator, bool AutoRehash, bool StoreHash, class BucketPolicy, bool Fingerprint, bool IncrementalRehash, bool Statistics, class Index, bool ShrinkOnErase>
+    static void save(const single_buffer_hash_set<Key, Hash, Pred, Allocator, AutoRehash, StoreHash, BucketPolicy, Fingerprint, IncrementalRehash, Statistics, Index, ShrinkOnErase>& set, std::ostream& out) {
+        using set_type = std::remove_cvref_t<decltype(set)>;
+        using index = typename set_type::index;
+        static_assert(sbh_bucket_policy_id<BucketPolicy> != 0, "only the built-in bucket policies can be serialized");
+        constexpr bool is_string = sbh_frozen_key_traits<Key>::is_string;
+        static_assert(is_string || (std::is_trivially_copyable_v<Key> && !std::is_pointer_v<Key>),
+            "only trivially copyable keys and std::basic_string can be serialized");
+        if (set._is_small() && !set.empty()) {
+            // pҦeS}CAאּxs@إߤFƥ
+            set_type copy = set;
+            copy.rehash(1);
+            save(copy, out);
+            return;
+        }
+        std::size_t n = set.size();
+        std::size_t nbuckets = set.bucket_count();
+        // irehashi椤ɡA걵b±WAݭns걵@㪺
+        std::vector<index> relinked_next;
+        std::vector<index> relinked_buckets;
+        if (set.rehash_in_progress()) {
+            relinked_next.resize(n);
+            relinked_buckets.assign(nbuckets, set_type::npos);
+            for (std::size_t i = 0; i < n; ++i) {
+                index bucket_index = set._bucket_of_hash(set._hash_of(set.forward_lists[i]));
+                relinked_next[i] = relinked_buckets[bucket_index];
+                relinked_buckets[bucket_index] = static_cast<index>(i);
+            }
+        }
+
+        sbh_file_header header{};
+        std::memcpy(header.magic, sbh_file_header::expected_magic, sizeof(header.magic));
+        header.version = sbh_file_header::current_version;
+        header.endian = sbh_file_header::native_endian;
+        header.bucket_policy = sbh_bucket_policy_id<BucketPolicy>;
+        header.index_size = sizeof(index);
+        header.hash_size = StoreHash ? sizeof(std::size_t) : 0;
+        header.size = n;
+        header.bucket_count = nbuckets;
+        std::uint64_t pool_size = 0;
+        if constexpr (is_string) {
+            header.key_layout = 1;
+            header.key_size = sizeof(typename Key::value_type);
+            for (const auto& node : set.forward_lists) {
+                pool_size += node.payload.size();
+            }
+            header.keys_offset = _align(sizeof(header));
+            header.next_offset = _align(header.keys_offset + n * sizeof(sbh_string_ref));
+        }
+        else {
+            header.key_layout = 0;
+            header.key_size = sizeof(Key);
+            header.keys_offset = _align(sizeof(header));
+            header.next_offset = _align(header.keys_offset + n * sizeof(Key));
+        }
+        header.hashes_offset = _align(header.next_offset + n * sizeof(index));
+        header.buckets_offset = _align(header.hashes_offset + n * header.hash_size);
+        header.pool_offset = _align(header.buckets_offset + nbuckets * sizeof(index));
+        header.pool_size = pool_size;
+
+        std::uint64_t position = 0;
+        _write(out, &header, 1);
+        position += sizeof(header);
+        _pad(out, position, header.keys_offset);
+        if constexpr (is_string) {
+            std::uint64_t offset = 0;
+            for (const auto& node : set.forward_lists) {
+                sbh_string_ref ref{ offset, node.payload.size() };
+                _write(out, &ref, 1);
+                offset += ref.length;
+            }
+            position += n * sizeof(sbh_string_ref);
+        }
+        else {
+            for (const auto& node : set.forward_lists) {
+                _write(out, std::addressof(node.payload), 1);
+            }
+            position += n * sizeof(Key);
+        }
+        _pad(out, position, header.next_offset);
+        if (set.rehash_in_progress()) {
+            _write(out, relinked_next.data(), n);
+        }
+        else {
+            for (const auto& node : set.forward_lists) {
+                _write(out, &node.next, 1);
+            }
+        }
+        position += n * sizeof(index);
+        _pad(out, position, header.hashes_offset);
+        if constexpr (StoreHash) {
+            for (const auto& node : set.forward_lists) {
+                _write(out, &node.hash_code, 1);
+            }
+            position += n * sizeof(std::size_t);
+        }
+        _pad(out, position, header.buckets_offset);
+        _write(out, set.rehash_in_progress() ? relinked_buckets.data() : set.buckets.begin(), nbuckets);
+        position += nbuckets * sizeof(index);
+        _pad(out, position, header.pool_offset);
+        if constexpr (is_string) {
+            for (const auto& node : set.forward_lists) {
+                _write(out, node.payload.data(), node.payload.size());
+            }
+        }
+        if (!out) {
+            throw std::runtime_error("single_buffer_hash_set: failed to write");
+        }
+    }
+};
+
+// NsetgJoutAoutHGiҦ}
+template <class Key, class Hash, class Pred, class Allocator, bool AutoRehash, bool StoreHash, class BucketPolicy, bool Fingerprint, bool IncrementalRehash, bool Statistics, class Index, bool ShrinkOnErase>
+void sbh_save(const single_buffer_hash_set<Key, Hash, Pred, Allocator, AutoRehash, StoreHash, BucketPolicy, Fingerprint, IncrementalRehash, Statistics, Index, ShrinkOnErase>& set, std::ostream& out) {
+    sbh_serialization::save(set, out);
+}
+template <class Key, class Hash, class Pred, class Allocator, bool AutoRehash, bool StoreHash, class BucketPolicy, bool Fingerprint, bool IncrementalRehash, bool Statistics, class Index, bool ShrinkOnErase>
+void sbh_save(const single_buffer_hash_set<Key, Hash, Pred, Allocator, AutoRehash, StoreHash, BucketPolicy, Fingerprint, IncrementalRehash, Statistics, Index, ShrinkOnErase>& set, const std::filesystem::path& path) {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        throw std::runtime_error("single_buffer_hash_set: failed to open " + path.string());
+    }
+    sbh_serialization::save(set, out);
+    out.close();
+    if (!out) {
+        throw std::runtime_error("single_buffer_hash_set: failed to write " + path.string());
+    }
+}
+
+// ŪOMgɮ
+class sbh_mapped_file {
+    const std::byte* _data = nullptr;
+    std::size_t _size = 0;
+#if defined(_WIN32)
+    HANDLE _mapping = nullptr;
+#endif
+public:
+    sbh_mapped_file() noexcept = default;
+    explicit sbh_mapped_file(const std::filesystem::path& path) {
+#if defined(_WIN32)
+        HANDLE file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE) {
+            throw std::system_error(static_cast<int>(GetLastError()), std::system_category(), "CreateFileW");
+        }
+        LARGE_INTEGER size;
+        if (!GetFileSizeEx(file, &size)) {
+            DWORD error = GetLastError();
+            CloseHandle(file);
+            throw std::system_error(static_cast<int>(error), std::system_category(), "GetFileSizeEx");
+        }
+        _size = static_cast<std::size_t>(size.QuadPart);
+        if (_size != 0) {
+            _mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            DWORD error = GetLastError();
+            CloseHandle(file);
+            if (_mapping == nullptr) {
+                throw std::system_error(static_cast<int>(error), std::system_category(), "CreateFileMappingW");
+            }
+            _data = static_cast<const std::byte*>(MapViewOfFile(_mapping, FILE_MAP_READ, 0, 0, 0));
+            if (_data == nullptr) {
+                error = GetLastError();
+                CloseHandle(_mapping);
+                throw std::system_error(static_cast<int>(error), std::system_category(), "MapViewOfFile");
+            }
+        }
+        else {
+            CloseHandle(file);
+        }
+#else
+        int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) {
+            throw std::system_error(errno, std::generic_category(), "open");
+        }
+        struct stat status;
+        if (::fstat(fd, &status) != 0) {
+            int error = errno;
+            ::close(fd);
+            throw std::system_error(error, std::generic_category(), "fstat");
+        }
+        _size = static_cast<std::size_t>(status.st_size);
+        if (_size != 0) {
+            void* address = ::mmap(nullptr, _size, PROT_READ, MAP_SHARED, fd, 0);
+            int error = errno;
+            ::close(fd);
+            if (address == MAP_FAILED) {
+                throw std::system_error(error, std::generic_category(), "mmap");
+            }
+            _data = static_cast<const std::byte*>(address);
+        }
+        else {
+            ::close(fd);
+        }
+#endif
+    }
+    sbh_mapped_file(const sbh_mapped_file&) = delete;
+    sbh_mapped_file& operator=(const sbh_mapped_file&) = delete;
+    sbh_mapped_file(sbh_mapped_file&& other) noexcept
+        : _data(std::exchange(other._data, nullptr)), _size(std::exchange(other._size, 0))
+#if defined(_WIN32)
+        , _mapping(std::exchange(other._mapping, nullptr))
+#endif
+    {}
+    sbh_mapped_file& operator=(sbh_mapped_file&& other) noexcept {
+        if (this != &other) {
+            _unmap();
+            _data = std::exchange(other._data, nullptr);
+            _size = std::exchange(other._size, 0);
+#if defined(_WIN32)
+            _mapping = std::exchange(other._mapping, nullptr);
+#endif
+        }
+        return *this;
+    }
+    ~sbh_mapped_file() noexcept {
+        _unmap();
+    }
+    [[nodiscard]] const std::byte* data() const noexcept {
+        return _data;
+    }
+    [[nodiscard]] std::size_t size() const noexcept {
+        return _size;
+    }
+private:
+    void _unmap() noexcept {
+#if defined(_WIN32)
+        if (_data) {
+            UnmapViewOfFile(_data);
+        }
+        if (_mapping) {
+            CloseHandle(_mapping);
+        }
+#else
+        if (_data) {
+            ::munmap(const_cast<std::byte*>(_data), _size);
+        }
+#endif
+    }
+};
+
+// Hsbh_savegJɮ׫غcŪXAbMgOWjM
+// KeyBHashBPredBBucketPolicyPIndexPgJɪsingle_buffer_hash_setۦP
+// rHstd::basic_string_viewܡAjMɤ|غcr
+template <
+    class Key,
+    class Hash = std::hash<Key>,
+    class Pred = std::equal_to<Key>,
+    class BucketPolicy = sbh_prime_modulo,
+    class Index = std::uint32_t>
+class frozen_single_buffer_hash_set {
+    using _key_traits = sbh_frozen_key_traits<Key>;
+    static constexpr bool _is_string = _key_traits::is_string;
+    static_assert(sbh_bucket_policy_id<BucketPolicy> != 0, "only the built-in bucket policies can be serialized");
+public:
+    using key_type = Key;
+    using hasher = Hash;
+    using key_equal = Pred;
+    using hash_code_type = std::size_t;
+    using size_type = Index;
+    using index = Index;
+    static constexpr index npos = static_cast<index>(-1);
+    // jMɨϥΪ䫬OAr䬰std::basic_string_view
+    using key_view = typename _key_traits::view_type;
+    using value_type = typename _key_traits::value_type;
+    using const_reference = std::conditional_t<_is_string, value_type, const value_type&>;
+private:
+    using _char_type = typename _key_traits::char_type;
+    using _stored_key = typename _key_traits::stored_type;
+    sbh_mapped_file file;
+    const _stored_key* keys = nullptr;
+    const index* next = nullptr;
+    const std::size_t* hashes = nullptr;  // xsƭȮɬnullptr
+    const index* buckets = nullptr;
+    const _char_type* pool = nullptr;
+    std::uint64_t pool_size = 0;
+    size_type _size = 0;
+    size_type _bucket_count = 0;
+    [[no_unique_address]] [[msvc::no_unique_address]] hasher hash;
+    [[no_unique_address]] [[msvc::no_unique_address]] key_equal equal;
+    [[no_unique_address]] [[msvc::no_unique_address]] BucketPolicy bucket_policy;
+public:
+    class const_iterator {
+        const frozen_single_buffer_hash_set* _set = nullptr;
+        index _index = 0;
+    public:
+        using iterator_concept = std::random_access_iterator_tag;
+        using iterator_category = std::conditional_t<_is_string, std::input_iterator_tag, std::random_access_iterator_tag>;
+        using value_type = typename frozen_single_buffer_hash_set::value_type;
+        using difference_type = std::ptrdiff_t;
+        using reference = const_reference;
+        const_iterator() noexcept = default;
+        const_iterator(const frozen_single_buffer_hash_set* set, index i) noexcept :_set(set), _index(i) {}
+        [[nodiscard]] reference operator*() const noexcept {
+            return (*_set)[_index];
+        }
+        [[nodiscard]] reference operator[](difference_type offset) const noexcept {
+            return (*_set)[static_cast<index>(_index + offset)];
+        }
+        const_iterator& operator++() noexcept {
+            ++_index;
+            return *this;
+        }
+        const_iterator operator++(int) noexcept {
+            const_iterator temp = *this;
+            ++*this;
+            return temp;
+        }
+        const_iterator& operator--() noexcept {
+            --_index;
+            return *this;
+        }
+        const_iterator operator--(int) noexcept {
+            const_iterator temp = *this;
+            --*this;
+            return temp;
+        }
+        const_iterator& operator+=(difference_type offset) noexcept {
+            _index = static_cast<index>(_index + offset);
+            return *this;
+        }
+        const_iterator& operator-=(difference_type offset) noexcept {
+            _index = static_cast<index>(_index - offset);
+            return *this;
+        }
+        [[nodiscard]] const_iterator operator+(difference_type offset) const noexcept {
+            const_iterator temp = *this;
+            return temp += offset;
+        }
+        [[nodiscard]] friend const_iterator operator+(difference_type offset, const_iterator right) noexcept {
+            return right += offset;
+        }
+        [[nodiscard]] const_iterator operator-(difference_type offset) const noexcept {
+            const_iterator temp = *this;
+            return temp -= offset;
+        }
+        [[nodiscard]] difference_type operator-(const const_iterator& other) const noexcept {
+            return static_cast<difference_type>(_index) - static_cast<difference_type>(other._index);
+        }
+        [[nodiscard]] bool operator==(const const_iterator& other) const noexcept {
+            return _index == other._index;
+        }
+        [[nodiscard]] auto operator<=>(const const_iterator& other) const noexcept {
+            return _index <=> other._index;
+        }
+    };
+    static_assert(std::random_access_iterator<const_iterator>);
+    using iterator = const_iterator;
+
+    frozen_single_buffer_hash_set() noexcept = default;
+    // MgpathYAɮ׮榡ŮɩߥXstd::runtime_error
+    // FJOO(1)Aغcɤ|ˬdCӯޡFɮץiQI_ηlɡAЦbjMeIsvalidate()
+    explicit frozen_single_buffer_hash_set(const std::filesystem::path& path, const hasher& hashFunction = hasher(), const key_equal& equalFunction = key_equal())
+        : file(path), hash(hashFunction), equal(equalFunction) {
+        _attach(file.data(), file.size());
+    }
+    // ϥΤwbO餤ơAҦpOJ{ɮפeAdataͩRg󦹪
+    // data64줸
+    frozen_single_buffer_hash_set(const void* data, std::size_t size, const hasher& hashFunction = hasher(), const key_equal& equalFunction = key_equal())
+        : hash(hashFunction), equal(equalFunction) {
+        _attach(static_cast<const std::byte*>(data), size);
+    }
+    frozen_single_buffer_hash_set(const frozen_single_buffer_hash_set&) = delete;
+    frozen_single_buffer_hash_set& operator=(const frozen_single_buffer_hash_set&) = delete;
+    // ʫotherŪeAAVw浹󪺬Mg
+    frozen_single_buffer_hash_set(frozen_single_buffer_hash_set&& other) noexcept
+        : file(std::move(other.file)), keys(std::exchange(other.keys, nullptr)), next(std::exchange(other.next, nullptr)),
+        hashes(std::exchange(other.hashes, nullptr)), buckets(std::exchange(other.buckets, nullptr)), pool(std::exchange(other.pool, nullptr)),
+        pool_size(std::exchange(other.pool_size, 0)), _size(std::exchange(other._size, 0)), _bucket_count(std::exchange(other._bucket_count, 0)),
+        hash(std::move(other.hash)), equal(std::move(other.equal)), bucket_policy(other.bucket_policy) {
+    }
+    frozen_single_buffer_hash_set& operator=(frozen_single_buffer_hash_set&& other) noexcept {
+        if (this != &other) {
+            file = std::move(other.file);
+            keys = std::exchange(other.keys, nullptr);
+            next = std::exchange(other.next, nullptr);
+            hashes = std::exchange(other.hashes, nullptr);
+            buckets = std::exchange(other.buckets, nullptr);
+            pool = std::exchange(other.pool, nullptr);
+            pool_size = std::exchange(other.pool_size, 0);
+            _size = std::exchange(other._size, 0);
+            _bucket_count = std::exchange(other._bucket_count, 0);
+            hash = std::move(other.hash);
+            equal = std::move(other.equal);
+            bucket_policy = other.bucket_policy;
+        }
+        return *this;
+    }
+
+    [[nodiscard]] const_iterator begin() const noexcept {
+        return const_iterator(this, 0);
+    }
+    [[nodiscard]] const_iterator end() const noexcept {
+        return const_iterator(this, _size);
+    }
+    [[nodiscard]] size_type size() const noexcept {
+        return _size;
+    }
+    [[nodiscard]] bool empty() const noexcept {
+        return _size == 0;
+    }
+    [[nodiscard]] size_type bucket_count() const noexcept {
+        return _bucket_count;
+    }
+    [[nodiscard]] const_reference operator[](index i) const noexcept {
+        assert(i < _size);
+        if constexpr (_is_string) {
+            return value_type(pool + keys[i].offset, static_cast<std::size_t>(keys[i].length));
+        }
+        else {
+            return keys[i];
+        }
+    }
+    [[nodiscard]] index _index_find(key_view key) const {
+        return _index_find(key, _hash(key));
+    }
+    // Hwp⪺ƭȷjMAhash_codeغcɩҥΪƨƹkeyG
+    [[nodiscard]] index _index_find(key_view key, hash_code_type hash_code) const {
+        assert(hash_code == _hash(key));
+        if (_bucket_count == 0) {
+            return npos;
+        }
+        index now = buckets[bucket_policy(hash_code, _bucket_count)];
+        while (now != npos) {
+            if ((hashes == nullptr || hashes[now] == hash_code) && _equal(key, (*this)[now])) {
+                return now;
+            }
+            now = next[now];
+        }
+        return npos;
+    }
+    [[nodiscard]] const_iterator find(key_view key) const {
+        index temp = _index_find(key);
+        return temp == npos ?
+            end() :
+            begin() + temp;
+    }
+    [[nodiscard]] size_type count(key_view key) const {
+        return _index_find(key) != npos;
+    }
+    [[nodiscard]] bool contains(key_view key) const {
+        return _index_find(key) != npos;
+    }
+    [[nodiscard]] const_iterator find(key_view key, hash_code_type hash_code) const {
+        index temp = _index_find(key, hash_code);
+        return temp == npos ?
+            end() :
+            begin() + temp;
+    }
+    [[nodiscard]] bool contains(key_view key, hash_code_type hash_code) const {
+        return _index_find(key, hash_code) != npos;
+    }
+    [[nodiscard]] hasher hash_function() const noexcept(noexcept(hasher(hash))) {
+        return hash;
+    }
+    [[nodiscard]] key_equal key_eq() const noexcept(noexcept(key_equal(equal))) {
+        return equal;
+    }
+    // ˬdCnextPOnposΤpsize()BCӦr곣rABS`AŮɩߥXstd::runtime_error
+    // ݭnO(size() + bucket_count())ɶŪɮסFqLAle̦hu|jM䤣AӤ|Vɦs
+    void validate() const {
+        for (size_type i = 0; i < _size; ++i) {
+            if (next[i] != npos && next[i] >= _size) {
+                _invalid("next index out of range");
+            }
+            if constexpr (_is_string) {
+                if (keys[i].offset > pool_size || keys[i].length > pool_size - keys[i].offset) {
+                    _invalid("string pool out of range");
+                }
+            }
+        }
+        // CӸ`Iܦhݩ@AX`I`ƶWLsize()Yܦ`Φ@Ϊ`I
+        std::size_t visited = 0;
+        for (size_type b = 0; b < _bucket_count; ++b) {
+            for (index now = buckets[b]; now != npos; now = next[now]) {
+                if (now >= _size) {
+                    _invalid("bucket index out of range");
+                }
+                if (++visited > _size) {
+                    _invalid("chains contain a cycle");
+                }
+            }
+        }
+    }
+private:
+    // std::hash<std::basic_string>Pstd::hash<std::basic_string_view>ۦPrǦCOҦۦPG
+    [[nodiscard]] std::size_t _hash(key_view key) const {
+        if constexpr (!_is_string || std::is_invocable_v<const hasher&, key_view>) {
+            return hash(key);
+        }
+        else if constexpr (std::is_same_v<hasher, std::hash<Key>>) {
+            return std::hash<value_type>{}(key);
+        }
+        else {
+            return hash(Key(key));
+        }
+    }
+    // P_hashۦPAƤstring_viewɫغcȮɪKeyAϦۭq(Ҧpjpg)M
+    [[nodiscard]] bool _equal(key_view left, key_view right) const {
+        if constexpr (!_is_string || std::is_invocable_r_v<bool, const key_equal&, key_view, key_view>) {
+            return equal(left, right);
+        }
+        else if constexpr (std::is_same_v<key_equal, std::equal_to<Key>>) {
+            return left == right;
+        }
+        else {
+            return equal(Key(left), Key(right));
+        }
+    }
+    [[noreturn]] static void _invalid(const char* reason) {
+        throw std::runtime_error(std::string("frozen_single_buffer_hash_set: ") + reason);
+    }
+    template <class T>
+    [[nodiscard]] static const T* _section(const std::byte* data, std::size_t size, std::uint64_t offset, std::uint64_t count) {
+        if (offset % alignof(T) != 0 || offset > size || count > (size - offset) / sizeof(T)) {
+            _invalid("section out of range");
+        }
+        return reinterpret_cast<const T*>(data + offset);
+    }
+    void _attach(const std::byte* data, std::size_t size) {
+        if (reinterpret_cast<std::uintptr_t>(data) % sbh_serialization::_section_alignment != 0) {
+            _invalid("data is not aligned");
+        }
+        sbh_file_header header;
+        if (size < sizeof(header)) {
+            _invalid("file too small");
+        }
+        std::memcpy(&header, data, sizeof(header));
+        if (std::memcmp(header.magic, sbh_file_header::expected_magic, sizeof(header.magic)) != 0) {
+            _invalid("not a single_buffer_hash_set file");
+        }
+        if (header.version != sbh_file_header::current_version) {
+            _invalid("unsupported version");
+        }
+        if (header.endian != sbh_file_header::native_endian) {
+            _invalid("byte order mismatch");
+        }
+        if (header.bucket_policy != sbh_bucket_policy_id<BucketPolicy>) {
+            _invalid("bucket policy mismatch");
+        }
+        if (header.key_layout != (_is_string ? 1u : 0u)
+            || header.key_size != (_is_string ? sizeof(_char_type) : sizeof(Key))) {
+            _invalid("key type mismatch");
+        }
+        if (header.index_size != sizeof(index)) {
+            _invalid("index type mismatch");
+        }
+        if (header.hash_size != 0 && header.hash_size != sizeof(std::size_t)) {
+            _invalid("hash size mismatch");
+        }
+        if (header.size >= npos || header.bucket_count > npos) {
+            _invalid("too many elements");
+        }
+        _size = static_cast<size_type>(header.size);
+        _bucket_count = static_cast<size_type>(header.bucket_count);
+        keys = _section<_stored_key>(data, size, header.keys_offset, header.size);
+        next = _section<index>(data, size, header.next_offset, header.size);
+        hashes = header.hash_size ? _section<std::size_t>(data, size, header.hashes_offset, header.size) : nullptr;
+        buckets = _section<index>(data, size, header.buckets_offset, header.bucket_count);
+        if constexpr (_is_string) {
+            pool = _section<_char_type>(data, size, header.pool_offset, header.pool_size);
+            pool_size = header.pool_size;
+            // uˬd̫@ӦrAv@ˬdCӦrHOJO(1)A㪺ˬdvalidate()td
+            if (header.size && (keys[_size - 1].offset > header.pool_size
+                || keys[_size - 1].length > header.pool_size - keys[_size - 1].offset)) {
+                _invalid("string pool out of range");
+            }
+        }
+        bucket_policy.assign(_bucket_count);
+        // xsƭȮɡAHĤ@ӤˬdHashO_PgJɬۦP
+        if (hashes && _size && hashes[0] != _hash((*this)[0])) {
+            _invalid("hash function mismatch");
+        }
+    }
+};
+#else
+#error C++20 or later required
+#endif // _HAS_CXX20
+#endif // FROZEN_SINGLE_BUFFER_HASH_SET
\ No newline at end of file
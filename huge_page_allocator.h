@@ -0,0 +1,138 @@
+#pragma once
+#ifndef SBH_HUGE_PAGE_ALLOCATOR
+#define SBH_HUGE_PAGE_ALLOCATOR
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <new>
+#include <type_traits>
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#elif defined(__unix__) || defined(__APPLE__)
+#include <sys/mman.h>
+#endif
+#if _HAS_CXX20 || __cplusplus >= 202002L
+// HjtmjwİϡAּGBebjMɪTLBR
+// CjM|Hs@ӱP@Ӹ`IA4KBUo̴XGwyTLBRA2MBhTLB[\dXj512
+//
+// pthresholdtm浹operator newAltmHpage_sizeG
+//   LinuxGMAP_HUGETLB(ݭnƥOdj)AѮɧHmmaptm2MBϬqåHmadvise(MADV_HUGEPAGE)nDzj
+//   WindowsGMEM_LARGE_PAGES(ݭnSeLockMemoryPrivilege)AѮɧH@몺VirtualAlloctm
+//   LxGpage_sizeoperator new
+// ɥuݭnjpNP_tm覡A]tSAAҦҬҬ۵
+struct sbh_huge_pages {
+    static constexpr std::size_t page_size = std::size_t(2) << 20;
+    static constexpr std::size_t threshold = page_size;
+    [[nodiscard]] static constexpr std::size_t round_up(std::size_t bytes) noexcept {
+        return (bytes + page_size - 1) / page_size * page_size;
+    }
+    [[nodiscard]] static void* allocate(std::size_t bytes) {
+        std::size_t size = round_up(bytes);
+        if (size < bytes) {
+            throw std::bad_alloc();
+        }
+#if defined(_WIN32)
+        if (SIZE_T large = GetLargePageMinimum(); large != 0 && size % large == 0) {
+            if (void* p = VirtualAlloc(nullptr, size, MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES, PAGE_READWRITE)) {
+                return p;
+            }
+        }
+        if (void* p = VirtualAlloc(nullptr, size, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE)) {
+            return p;
+        }
+        throw std::bad_alloc();
+#elif defined(__unix__) || defined(__APPLE__)
+#ifdef MAP_HUGETLB
+        if (void* p = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+            p != MAP_FAILED) {
+            return p;
+        }
+#endif
+        // htm@AAYϰϬqpage_sizeAzju|ΦbϬqW
+        void* reserved = ::mmap(nullptr, size + page_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (reserved == MAP_FAILED) {
+            throw std::bad_alloc();
+        }
+        std::uintptr_t first = reinterpret_cast<std::uintptr_t>(reserved);
+        std::uintptr_t aligned = (first + page_size - 1) / page_size * page_size;
+        if (aligned != first) {
+            ::munmap(reserved, aligned - first);
+        }
+        if (std::size_t tail = first + size + page_size - (aligned + size); tail != 0) {
+            ::munmap(reinterpret_cast<void*>(aligned + size), tail);
+        }
+        void* p = reinterpret_cast<void*>(aligned);
+#ifdef MADV_HUGEPAGE
+        ::madvise(p, size, MADV_HUGEPAGE);
+#endif
+        return p;
+#else
+        return ::operator new(size, std::align_val_t(page_size));
+#endif
+    }
+    static void deallocate(void* p, [[maybe_unused]] std::size_t bytes) noexcept {
+#if defined(_WIN32)
+        VirtualFree(p, 0, MEM_RELEASE);
+#elif defined(__unix__) || defined(__APPLE__)
+        ::munmap(p, round_up(bytes));
+#else
+        ::operator delete(p, std::align_val_t(page_size));
+#endif
+    }
+};
+
+template <class T>
+class sbh_huge_page_allocator {
+public:
+    using value_type = T;
+    using is_always_equal = std::true_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    sbh_huge_page_allocator() noexcept = default;
+    template <class U>
+    sbh_huge_page_allocator(const sbh_huge_page_allocator<U>&) noexcept {}
+    [[nodiscard]] T* allocate(std::size_t n) {
+        if (n > (std::numeric_limits<std::size_t>::max)() / sizeof(T)) {
+            throw std::bad_array_new_length();
+        }
+        std::size_t bytes = n * sizeof(T);
+        if (bytes < sbh_huge_pages::threshold) {
+            if constexpr (alignof(T) > __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+                return static_cast<T*>(::operator new(bytes, std::align_val_t(alignof(T))));
+            }
+            else {
+                return static_cast<T*>(::operator new(bytes));
+            }
+        }
+        return static_cast<T*>(sbh_huge_pages::allocate(bytes));
+    }
+    void deallocate(T* p, std::size_t n) noexcept {
+        std::size_t bytes = n * sizeof(T);
+        if (bytes < sbh_huge_pages::threshold) {
+            if constexpr (alignof(T) > __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+                ::operator delete(p, std::align_val_t(alignof(T)));
+            }
+            else {
+                ::operator delete(p);
+            }
+        }
+        else {
+            sbh_huge_pages::deallocate(p, bytes);
+        }
+    }
+    [[nodiscard]] friend bool operator==(const sbh_huge_page_allocator&, const sbh_huge_page_allocator&) noexcept {
+        return true;
+    }
+};
+// POtuŧi@AקKCӯSƦU۪`J@ӭԿ禡Ӳͪ[q
+// ҦҳϥΦP@ӥ쪺tmӷA]`O۵
+template <class T, class U>
+[[nodiscard]] bool operator==(const sbh_huge_page_allocator<T>&, const sbh_huge_page_allocator<U>&) noexcept {
+    return true;
+}
+#else
+#error C++20 or later required
+#endif // _HAS_CXX20
+#endif // SBH_HUGE_PAGE_ALLOCATOR
\ No newline at end of file
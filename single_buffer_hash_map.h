@@ -0,0 +1,705 @@
+#pragma once
+#ifndef SINGLE_BUFFER_HASH_MAP
+#define SINGLE_BUFFER_HASH_MAP
+#include "single_buffer_hash_set.h"
+#include <stdexcept>
+#include <utility>
+#if _HAS_CXX20 || __cplusplus >= 202002L
+template <
+    class Key,
+    class T,
+    class Hash = std::hash<Key>,
+    class Pred = std::equal_to<Key>,
+    class Allocator = std::allocator<std::pair<Key, T>>,
+    bool AutoRehash = true,
+    bool StoreHash = sbh_default_store_hash<Hash>,
+    class BucketPolicy = sbh_prime_modulo,
+    bool Fingerprint = false,
+    bool IncrementalRehash = false,
+    bool Statistics = false,
+    class Index = std::uint32_t,
+    bool ShrinkOnErase = false>
+class single_buffer_hash_map {
+    static_assert(std::is_same_v<typename std::allocator_traits<Allocator>::value_type, std::pair<Key, T>>,
+        "Allocator::value_type must be the same as std::pair<Key, T>");
+    // PȦsbPwİϤA|tmstd::pair<Key, T>AAllocatoruOOsjwKeyPTt
+    using _key_allocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Key>;
+    using _mapped_allocator = typename std::allocator_traits<Allocator>::template rebind_alloc<T>;
+    using key_set = single_buffer_hash_set<Key, Hash, Pred, _key_allocator, AutoRehash, StoreHash, BucketPolicy, Fingerprint, IncrementalRehash, Statistics, Index, ShrinkOnErase>;
+public:
+    using key_type = Key;
+    using mapped_type = T;
+    using value_type = std::pair<Key, T>;
+    using reference = std::pair<const Key&, T&>;
+    using const_reference = std::pair<const Key&, const T&>;
+    using size_type = typename key_set::size_type;
+    using difference_type = std::ptrdiff_t;
+    using hasher = Hash;
+    using key_equal = Pred;
+    using allocator_type = Allocator;
+    using hash_code_type = typename key_set::hash_code_type;
+
+    using index = typename key_set::index;
+    static constexpr index npos = key_set::npos;
+    constexpr size_type max_size() const noexcept {
+        return keys.max_size();
+    }
+    constexpr size_type max_bucket_count() const noexcept {
+        return keys.max_bucket_count();
+    }
+private:
+    // OƦ
+    // PȤOsbӳs򪺽wİϤḀHۦPindex
+    // Xɥu|IA|]ȪjpӭC֨Ĳv
+    key_set keys;
+    std::vector<T, _mapped_allocator> values;
+    static constexpr bool _is_transparent = requires {
+        typename Hash::is_transparent;
+        typename Pred::is_transparent;
+    };
+    // KiHΨӫغckey_typeAB|PJhVc
+    template <class K>
+    static constexpr bool _is_hetero_key = _is_transparent
+        && std::is_constructible_v<key_type, K&&>
+        && !std::is_same_v<std::remove_cvref_t<K>, key_type>;
+
+    // NѰѦҫo쪺OȮɪpairA]operator->^Ǥ@ӥNz
+    template <class Ref>
+    struct _arrow_proxy {
+        Ref _ref;
+        [[nodiscard]] Ref* operator->() noexcept {
+            return std::addressof(_ref);
+        }
+    };
+    template <bool Const>
+    class _iterator {
+        friend class single_buffer_hash_map;
+        template <bool> friend class _iterator;
+        using key_iterator = typename key_set::const_iterator;
+        using mapped_pointer = std::conditional_t<Const, const T*, T*>;
+        key_iterator _key;
+        mapped_pointer _mapped;
+    public:
+        // ѰѦұo쪺ONzpairAbC++23eLkstd::indirectly_readableA
+        // GuѶǲΪN
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = typename single_buffer_hash_map::value_type;
+        using difference_type = std::ptrdiff_t;
+        using distance_type = std::ptrdiff_t;
+        using reference = std::conditional_t<Const,
+            typename single_buffer_hash_map::const_reference,
+            typename single_buffer_hash_map::reference>;
+        using pointer = _arrow_proxy<reference>;
+        _iterator(key_iterator key, mapped_pointer mapped) noexcept :_key(key), _mapped(mapped) {};
+        _iterator() noexcept :_key(), _mapped(nullptr) {};
+        // \iteratorഫconst_iterator
+        template <bool OtherConst>
+            requires (Const && !OtherConst)
+        _iterator(const _iterator<OtherConst>& other) noexcept
+            :_key(other._key), _mapped(other._mapped) {};
+        [[nodiscard]] reference operator*() const noexcept {
+            return { *_key, *_mapped };
+        }
+        [[nodiscard]] pointer operator->() const noexcept {
+            return { **this };
+        }
+        [[nodiscard]] reference operator[](const difference_type offset) const noexcept {
+            return { _key[offset], _mapped[offset] };
+        }
+        // DзǡGgLpairoP
+        [[nodiscard]] const key_type& key() const noexcept {
+            return *_key;
+        }
+        [[nodiscard]] auto& value() const noexcept {
+            return *_mapped;
+        }
+        _iterator& operator++() noexcept {
+            ++_key;
+            ++_mapped;
+            return *this;
+        }
+        _iterator operator++(int) noexcept {
+            _iterator temp = *this;
+            ++*this;
+            return temp;
+        }
+        _iterator& operator--() noexcept {
+            --_key;
+            --_mapped;
+            return *this;
+        }
+        _iterator operator--(int) noexcept {
+            _iterator temp = *this;
+            --*this;
+            return temp;
+        }
+        _iterator& operator+=(const difference_type offset) noexcept {
+            _key += offset;
+            _mapped += offset;
+            return *this;
+        }
+        [[nodiscard]] _iterator operator+(const difference_type offset) const noexcept {
+            return _iterator(_key + offset, _mapped + offset);
+        }
+        [[nodiscard]] friend _iterator operator+(
+            const difference_type offset, _iterator right) noexcept {
+            return right + offset;
+        }
+        _iterator& operator-=(const difference_type offset) noexcept {
+            _key -= offset;
+            _mapped -= offset;
+            return *this;
+        }
+        [[nodiscard]] _iterator operator-(const difference_type offset) const noexcept {
+            return _iterator(_key - offset, _mapped - offset);
+        }
+        [[nodiscard]] difference_type operator-(const _iterator& other) const noexcept {
+            return _key - other._key;
+        }
+        // PȪmûPBAu䤤@ӧYi
+        [[nodiscard]] bool operator==(const _iterator& other) const noexcept {
+            return _key == other._key;
+        }
+        [[nodiscard]] auto operator<=>(const _iterator& other) const noexcept {
+            return _key <=> other._key;
+        }
+    };
+public:
+    using iterator = _iterator<false>;
+    using const_iterator = _iterator<true>;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    [[nodiscard]] iterator begin() noexcept {
+        return iterator(keys.begin(), values.data());
+    }
+    [[nodiscard]] const_iterator begin() const noexcept {
+        return const_iterator(keys.begin(), values.data());
+    }
+    [[nodiscard]] const_iterator cbegin() const noexcept {
+        return begin();
+    }
+    [[nodiscard]] iterator end() noexcept {
+        return begin() + size();
+    }
+    [[nodiscard]] const_iterator end() const noexcept {
+        return begin() + size();
+    }
+    [[nodiscard]] const_iterator cend() const noexcept {
+        return end();
+    }
+    [[nodiscard]] reverse_iterator rbegin() noexcept {
+        return reverse_iterator(end());
+    }
+    [[nodiscard]] const_reverse_iterator rbegin() const noexcept {
+        return const_reverse_iterator(end());
+    }
+    [[nodiscard]] const_reverse_iterator rcbegin() const noexcept {
+        return rbegin();
+    }
+    [[nodiscard]] reverse_iterator rend() noexcept {
+        return reverse_iterator(begin());
+    }
+    [[nodiscard]] const_reverse_iterator rend() const noexcept {
+        return const_reverse_iterator(begin());
+    }
+    [[nodiscard]] const_reverse_iterator rcend() const noexcept {
+        return rend();
+    }
+
+    // غc禡
+    // ۰ʺ޲z
+    explicit single_buffer_hash_map(size_type bucket_count = 0, size_type initialCapacity = 0, const hasher& hashFunction = hasher(), const key_equal& equalFunction = key_equal(), const allocator_type& alloc = allocator_type())
+        requires AutoRehash
+    : keys(bucket_count, initialCapacity, hashFunction, equalFunction, _key_allocator(alloc)), values(_mapped_allocator(alloc)) {
+        values.reserve(initialCapacity);
+    }
+    explicit single_buffer_hash_map(const allocator_type& alloc)
+        requires AutoRehash
+    : single_buffer_hash_map(0, 0, hasher(), key_equal(), alloc) {
+    }
+    // ʺ޲zAbغc禡Xlƶq
+    // The initial number of buckets must be given explicitly
+    explicit single_buffer_hash_map(size_type bucket_count, size_type initialCapacity = 0, const hasher& hashFunction = hasher(), const key_equal& equalFunction = key_equal(), const allocator_type& alloc = allocator_type())
+        requires (!AutoRehash)
+    : keys(bucket_count, initialCapacity, hashFunction, equalFunction, _key_allocator(alloc)), values(_mapped_allocator(alloc)) {
+        values.reserve(initialCapacity);
+    }
+    single_buffer_hash_map(const single_buffer_hash_map& other, const allocator_type& alloc)
+    : keys(other.keys, _key_allocator(alloc)), values(other.values, _mapped_allocator(alloc)) {
+    }
+    single_buffer_hash_map(single_buffer_hash_map&& other, const allocator_type& alloc)
+    : keys(std::move(other.keys), _key_allocator(alloc)), values(std::move(other.values), _mapped_allocator(alloc)) {
+    }
+    single_buffer_hash_map(const single_buffer_hash_map&) = default;
+    single_buffer_hash_map(single_buffer_hash_map&&) = default;
+    single_buffer_hash_map& operator=(const single_buffer_hash_map&) = default;
+    single_buffer_hash_map& operator=(single_buffer_hash_map&&) = default;
+    [[nodiscard]] allocator_type get_allocator() const noexcept {
+        return allocator_type(keys.get_allocator());
+    }
+
+    [[nodiscard]] size_type bucket(const key_type& key) const
+        noexcept(noexcept(keys.bucket(key))) {
+        return keys.bucket(key);
+    }
+    [[nodiscard]] size_type bucket_count() const noexcept {
+        return keys.bucket_count();
+    }
+    [[nodiscard]] size_type bucket_size(size_type nbucket) const noexcept {
+        return keys.bucket_size(nbucket);
+    }
+    [[nodiscard]] float load_factor() const noexcept {
+        return keys.load_factor();
+    }
+    [[nodiscard]] float max_load_factor() const noexcept {
+        return keys.max_load_factor();
+    }
+    void max_load_factor(float factor) noexcept
+        requires AutoRehash {
+        keys.max_load_factor(factor);
+    }
+    [[nodiscard]] float min_load_factor() const noexcept {
+        return keys.min_load_factor();
+    }
+    void min_load_factor(float factor) noexcept
+        requires ShrinkOnErase {
+        keys.min_load_factor(factor);
+    }
+    [[nodiscard]] size_type size() const noexcept {
+        return keys.size();
+    }
+    [[nodiscard]] bool empty() const noexcept {
+        return keys.empty();
+    }
+    void rehash(size_type nbuckets) {
+        keys.rehash(nbuckets);
+    }
+    //wOdΩsPȪO
+    //AutoRehashɡA]|@ּW[
+    void reserve(size_type newcapacity) {
+        keys.reserve(newcapacity);
+        values.reserve(newcapacity);
+    }
+    size_type capacity() const noexcept {
+        return (std::min)(keys.capacity(), static_cast<size_type>(values.capacity()));
+    }
+    void clear() noexcept {
+        keys.clear();
+        values.clear();
+    }
+    void shrink_to_fit() {
+        keys.shrink_to_fit();
+        values.shrink_to_fit();
+    }
+    void compact() {
+        keys.compact();
+        values.shrink_to_fit();
+    }
+    //eϥΪҦ귽AϮeB󤣥iϥΦӥiBRcƪAC
+    void destroy_container() noexcept {
+        keys.destroy_container();
+        values.clear();
+        values.shrink_to_fit();
+    }
+    [[nodiscard]] bool rehash_in_progress() const noexcept {
+        return keys.rehash_in_progress();
+    }
+    void finish_rehash()
+        noexcept(noexcept(keys.finish_rehash()))
+        requires IncrementalRehash {
+        keys.finish_rehash();
+    }
+    // έpTu[\䪺AbytesPpeak_bytes]tȪwİ
+    [[nodiscard]] sbh_statistics stats() const {
+        return keys.stats();
+    }
+    void reset_stats() noexcept
+        requires Statistics {
+        keys.reset_stats();
+    }
+
+    [[nodiscard]] index _index_find(const key_type& keyval)
+        const noexcept(noexcept(keys._index_find(keyval))) {
+        return keys._index_find(keyval);
+    }
+    [[nodiscard]] iterator find(const key_type& keyval)
+        noexcept(noexcept(keys._index_find(keyval))) {
+        index temp = _index_find(keyval);
+        return temp == npos ?
+            end() :
+            begin() + temp;
+    }
+    [[nodiscard]] const_iterator find(const key_type& keyval)
+        const noexcept(noexcept(keys._index_find(keyval))) {
+        index temp = _index_find(keyval);
+        return temp == npos ?
+            end() :
+            begin() + temp;
+    }
+    [[nodiscard]] size_type count(const key_type& key)
+        const noexcept(noexcept(keys._index_find(key))) {
+        return _index_find(key) != npos;
+    }
+    [[nodiscard]] bool contains(const key_type& key)
+        const noexcept(noexcept(keys._index_find(key))) {
+        return count(key);
+    }
+    [[nodiscard]] T& at(const key_type& key) {
+        index temp = _index_find(key);
+        if (temp == npos) {
+            throw std::out_of_range("invalid single_buffer_hash_map<K, T> key");
+        }
+        return values[temp];
+    }
+    [[nodiscard]] const T& at(const key_type& key) const {
+        index temp = _index_find(key);
+        if (temp == npos) {
+            throw std::out_of_range("invalid single_buffer_hash_map<K, T> key");
+        }
+        return values[temp];
+    }
+    T& operator[](const key_type& key) {
+        return values[_index_try_emplace(key).first];
+    }
+    T& operator[](key_type&& key) {
+        return values[_index_try_emplace(std::move(key)).first];
+    }
+    // dPJAҦpHstd::string_viewsHstd::string䪺e
+    template <class K>
+        requires _is_transparent
+    [[nodiscard]] index _index_find(const K& keyval)
+        const noexcept(noexcept(keys._index_find(keyval))) {
+        return keys._index_find(keyval);
+    }
+    template <class K>
+        requires _is_transparent
+    [[nodiscard]] iterator find(const K& keyval)
+        noexcept(noexcept(keys._index_find(keyval))) {
+        index temp = _index_find(keyval);
+        return temp == npos ?
+            end() :
+            begin() + temp;
+    }
+    template <class K>
+        requires _is_transparent
+    [[nodiscard]] const_iterator find(const K& keyval)
+        const noexcept(noexcept(keys._index_find(keyval))) {
+        index temp = _index_find(keyval);
+        return temp == npos ?
+            end() :
+            begin() + temp;
+    }
+    template <class K>
+        requires _is_transparent
+    [[nodiscard]] size_type count(const K& key)
+        const noexcept(noexcept(keys._index_find(key))) {
+        return _index_find(key) != npos;
+    }
+    template <class K>
+        requires _is_transparent
+    [[nodiscard]] bool contains(const K& key)
+        const noexcept(noexcept(keys._index_find(key))) {
+        return _index_find(key) != npos;
+    }
+    // Hwp⪺ƭȷjMAhash_codehash_function()(key)
+    [[nodiscard]] index _index_find(const key_type& keyval, hash_code_type hash_code)
+        const noexcept(noexcept(keys._index_find(keyval, hash_code))) {
+        return keys._index_find(keyval, hash_code);
+    }
+    [[nodiscard]] iterator find(const key_type& keyval, hash_code_type hash_code)
+        noexcept(noexcept(keys._index_find(keyval, hash_code))) {
+        index temp = _index_find(keyval, hash_code);
+        return temp == npos ?
+            end() :
+            begin() + temp;
+    }
+    [[nodiscard]] const_iterator find(const key_type& keyval, hash_code_type hash_code)
+        const noexcept(noexcept(keys._index_find(keyval, hash_code))) {
+        index temp = _index_find(keyval, hash_code);
+        return temp == npos ?
+            end() :
+            begin() + temp;
+    }
+    [[nodiscard]] bool contains(const key_type& key, hash_code_type hash_code)
+        const noexcept(noexcept(keys._index_find(key, hash_code))) {
+        return _index_find(key, hash_code) != npos;
+    }
+    template <class K>
+        requires _is_transparent
+    [[nodiscard]] index _index_find(const K& keyval, hash_code_type hash_code)
+        const noexcept(noexcept(keys._index_find(keyval, hash_code))) {
+        return keys._index_find(keyval, hash_code);
+    }
+    template <class K>
+        requires _is_transparent
+    [[nodiscard]] iterator find(const K& keyval, hash_code_type hash_code)
+        noexcept(noexcept(keys._index_find(keyval, hash_code))) {
+        index temp = _index_find(keyval, hash_code);
+        return temp == npos ?
+            end() :
+            begin() + temp;
+    }
+    template <class K>
+        requires _is_transparent
+    [[nodiscard]] const_iterator find(const K& keyval, hash_code_type hash_code)
+        const noexcept(noexcept(keys._index_find(keyval, hash_code))) {
+        index temp = _index_find(keyval, hash_code);
+        return temp == npos ?
+            end() :
+            begin() + temp;
+    }
+    template <class K>
+        requires _is_transparent
+    [[nodiscard]] bool contains(const K& key, hash_code_type hash_code)
+        const noexcept(noexcept(keys._index_find(key, hash_code))) {
+        return _index_find(key, hash_code) != npos;
+    }
+    template <class K>
+        requires _is_transparent
+    [[nodiscard]] T& at(const K& key) {
+        index temp = _index_find(key);
+        if (temp == npos) {
+            throw std::out_of_range("invalid single_buffer_hash_map<K, T> key");
+        }
+        return values[temp];
+    }
+    template <class K>
+        requires _is_transparent
+    [[nodiscard]] const T& at(const K& key) const {
+        index temp = _index_find(key);
+        if (temp == npos) {
+            throw std::out_of_range("invalid single_buffer_hash_map<K, T> key");
+        }
+        return values[temp];
+    }
+    template <class K>
+        requires _is_hetero_key<K>
+    T& operator[](K&& key) {
+        return values[_index_try_emplace_impl(std::forward<K>(key)).first];
+    }
+
+    // ub䤣sbɤ~|HargsغcȡA_hargs|Q
+    template <class... Args>
+    std::pair<index, bool> _index_try_emplace(const key_type& key, Args&&... args) {
+        return _index_try_emplace_impl(key, std::forward<Args>(args)...);
+    }
+    template <class... Args>
+    std::pair<index, bool> _index_try_emplace(key_type&& key, Args&&... args) {
+        return _index_try_emplace_impl(std::move(key), std::forward<Args>(args)...);
+    }
+    template <class... Args>
+    std::pair<iterator, bool> try_emplace(const key_type& key, Args&&... args) {
+        auto temp = _index_try_emplace(key, std::forward<Args>(args)...);
+        return { begin() + temp.first,temp.second };
+    }
+    template <class... Args>
+    std::pair<iterator, bool> try_emplace(key_type&& key, Args&&... args) {
+        auto temp = _index_try_emplace(std::move(key), std::forward<Args>(args)...);
+        return { begin() + temp.first,temp.second };
+    }
+    // ub䤣sbɤ~|Hkeyغcs
+    template <class K, class... Args>
+        requires (_is_hetero_key<K>
+            && !std::is_convertible_v<K&&, const_iterator>
+            && !std::is_convertible_v<K&&, iterator>)
+    std::pair<index, bool> _index_try_emplace(K&& key, Args&&... args) {
+        return _index_try_emplace_impl(std::forward<K>(key), std::forward<Args>(args)...);
+    }
+    template <class K, class... Args>
+        requires (_is_hetero_key<K>
+            && !std::is_convertible_v<K&&, const_iterator>
+            && !std::is_convertible_v<K&&, iterator>)
+    std::pair<iterator, bool> try_emplace(K&& key, Args&&... args) {
+        auto temp = _index_try_emplace_impl(std::forward<K>(key), std::forward<Args>(args)...);
+        return { begin() + temp.first,temp.second };
+    }
+    template <class M>
+    std::pair<index, bool> _index_insert_or_assign(const key_type& key, M&& obj) {
+        return _index_insert_or_assign_impl(key, std::forward<M>(obj));
+    }
+    template <class M>
+    std::pair<index, bool> _index_insert_or_assign(key_type&& key, M&& obj) {
+        return _index_insert_or_assign_impl(std::move(key), std::forward<M>(obj));
+    }
+    template <class M>
+    std::pair<iterator, bool> insert_or_assign(const key_type& key, M&& obj) {
+        auto temp = _index_insert_or_assign(key, std::forward<M>(obj));
+        return { begin() + temp.first,temp.second };
+    }
+    template <class M>
+    std::pair<iterator, bool> insert_or_assign(key_type&& key, M&& obj) {
+        auto temp = _index_insert_or_assign(std::move(key), std::forward<M>(obj));
+        return { begin() + temp.first,temp.second };
+    }
+    template <class K, class M>
+        requires _is_hetero_key<K>
+    std::pair<index, bool> _index_insert_or_assign(K&& key, M&& obj) {
+        return _index_insert_or_assign_impl(std::forward<K>(key), std::forward<M>(obj));
+    }
+    template <class K, class M>
+        requires _is_hetero_key<K>
+    std::pair<iterator, bool> insert_or_assign(K&& key, M&& obj) {
+        auto temp = _index_insert_or_assign_impl(std::forward<K>(key), std::forward<M>(obj));
+        return { begin() + temp.first,temp.second };
+    }
+    std::pair<index, bool> _index_insert(const value_type& value) {
+        return _index_try_emplace(value.first, value.second);
+    }
+    std::pair<index, bool> _index_insert(value_type&& value) {
+        return _index_try_emplace(std::move(value.first), std::move(value.second));
+    }
+    std::pair<iterator, bool> insert(const value_type& value) {
+        auto temp = _index_insert(value);
+        return { begin() + temp.first,temp.second };
+    }
+    std::pair<iterator, bool> insert(value_type&& value) {
+        auto temp = _index_insert(std::move(value));
+        return { begin() + temp.first,temp.second };
+    }
+    // Pstd::unordered_mapۦPAغcXpair~o
+    template <class... Args>
+    std::pair<index, bool> _index_emplace(Args&&... args) {
+        value_type temp(std::forward<Args>(args)...);
+        return _index_try_emplace(std::move(temp.first), std::move(temp.second));
+    }
+    template <class... Args>
+    std::pair<iterator, bool> emplace(Args&&... args) {
+        auto temp = _index_emplace(std::forward<Args>(args)...);
+        return { begin() + temp.first,temp.second };
+    }
+
+    size_type erase(const key_type& key) {
+        return _erase_key(key);
+    }
+    template <class K>
+        requires (_is_transparent
+            && !std::is_convertible_v<K&&, const_iterator>
+            && !std::is_convertible_v<K&&, iterator>)
+    size_type erase(K&& key) {
+        return _erase_key(key);
+    }
+    //Psingle_buffer_hash_setۦPA|H̫@Ӥɪů
+    void _index_erase(index Where)
+        noexcept(noexcept(keys._index_erase(0))
+            && std::is_nothrow_move_assignable_v<T>) {
+        assert(Where < size());
+        keys._index_erase(Where);
+        if (Where != values.size() - 1) {
+            values[Where] = std::move(values.back());
+        }
+        values.pop_back();
+    }
+    void erase(const_iterator Where)
+        noexcept(noexcept(_index_erase(0))) {
+        _index_erase(static_cast<index>(Where - cbegin()));
+    }
+    // 妸APsingle_buffer_hash_setۦPAH@íwyYPȡA̫Aؤ@
+    iterator erase(const_iterator first, const_iterator last) {
+        index first_index = static_cast<index>(first - cbegin());
+        index last_index = static_cast<index>(last - cbegin());
+        if (first_index != last_index) {
+            _index_erase_if([=](index i) {
+                return i >= first_index && i < last_index;
+            });
+        }
+        return begin() + first_index;
+    }
+    template <std::forward_iterator InputIt, std::sentinel_for<InputIt> Sentinel>
+    size_type erase_many(InputIt first, Sentinel last) {
+        return _compact([&](auto relocate) {
+            return keys._index_erase_many(first, last, relocate);
+        });
+    }
+    template <class Predicate>
+    friend size_type erase_if(single_buffer_hash_map& map, Predicate pred) {
+        return map._index_erase_if([&](index i) {
+            return pred(reference(map.keys.begin()[i], map.values[i]));
+        });
+    }
+    template <class Remove>
+    size_type _index_erase_if(Remove remove) {
+        return _compact([&](auto relocate) {
+            return keys._index_erase_if(std::move(remove), relocate);
+        });
+    }
+
+    [[nodiscard]] hasher hash_function() const noexcept(noexcept(keys.hash_function())) {
+        return keys.hash_function();
+    }
+    [[nodiscard]] key_equal key_eq() const noexcept(noexcept(keys.key_eq())) {
+        return keys.key_eq();
+    }
+private:
+    // Herase_indexbjMPɲAAq}YX@
+    template <class K>
+    size_type _erase_key(const K& key) {
+        size_type erased = keys.erase_index(key, [this](index from, index to) {
+            values[to] = std::move(values[from]);
+        });
+        if (erased != 0) {
+            values.pop_back();
+        }
+        return erased;
+    }
+    // YɱNOdUӪȲۦPmA̫Ihhl
+    // YY䪺L{ߥXҥ~A]wgYAȤI_H̹
+    template <class CompactKeys>
+    size_type _compact(CompactKeys compact_keys) {
+        auto relocate = [this](index from, index to) {
+            values[to] = std::move(values[from]);
+        };
+        size_type removed;
+        try {
+            removed = compact_keys(relocate);
+        }
+        catch (...) {
+            values.erase(values.begin() + keys.size(), values.end());
+            throw;
+        }
+        values.erase(values.begin() + keys.size(), values.end());
+        return removed;
+    }
+    template <class K, class... Args>
+    std::pair<index, bool> _index_try_emplace_impl(K&& key, Args&&... args) {
+        auto temp = keys._index_insert(std::forward<K>(key));
+        if (temp.second) {
+            try {
+                values.emplace_back(std::forward<Args>(args)...);
+            }
+            catch (...) {
+                //sJ䥲w̫A|ʨL
+                keys._index_erase(temp.first);
+                throw;
+            }
+        }
+        return temp;
+    }
+    template <class K, class M>
+    std::pair<index, bool> _index_insert_or_assign_impl(K&& key, M&& obj) {
+        auto temp = _index_try_emplace_impl(std::forward<K>(key), std::forward<M>(obj));
+        if (!temp.second) {
+            values[temp.first] = std::forward<M>(obj);
+        }
+        return temp;
+    }
+};
+template <
+    class Key,
+    class T,
+    class Hash = std::hash<Key>,
+    class Pred = std::equal_to<Key>,
+    bool AutoRehash = true,
+    bool StoreHash = sbh_default_store_hash<Hash>,
+    class BucketPolicy = sbh_prime_modulo,
+    bool Fingerprint = false,
+    bool IncrementalRehash = false,
+    bool Statistics = false,
+    class Index = std::uint32_t,
+    bool ShrinkOnErase = false>
+using pmr_single_buffer_hash_map = single_buffer_hash_map<Key, T, Hash, Pred, std::pmr::polymorphic_allocator<std::pair<Key, T>>,
+    AutoRehash, StoreHash, BucketPolicy, Fingerprint, IncrementalRehash, Statistics, Index, ShrinkOnErase>;
+#else
+#error C++20 or later required
+#endif // _HAS_CXX20
+#endif // SINGLE_BUFFER_HASH_MAP
\ No newline at end of file
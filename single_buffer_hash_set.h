@@ -2,44 +2,280 @@
 #ifndef SINGLE_BUFFER_HASH_SET
 #define SINGLE_BUFFER_HASH_SET
 #include <vector>
+#include <memory>
+#include <memory_resource>
 #include <cassert>
 #include <variant>
 #include <cstdint>
 #include <limits>
 #include <algorithm>
+#include <functional>
+#include <type_traits>
+#include <bit>
+#include <iterator>
+#include <utility>
+#include <chrono>
+#include <stdexcept>
+#ifndef SINGLE_BUFFER_HASH_SET_NO_THREADS
+#include <thread>
+#include <exception>
+#endif
+#include <ranges>
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#endif
 #if _HAS_CXX20 || __cplusplus >= 202002L
+// P_ƨƬO_KyAHܩ󤣭ȱob`I֨ƭ
+// ϥΪ̥iHwۤvƨƯSƦO
+template <class Hash>
+struct sbh_is_fast_hash : std::false_type {};
+template <class T>
+    requires (std::is_arithmetic_v<T> || std::is_enum_v<T> || std::is_pointer_v<T>)
+struct sbh_is_fast_hash<std::hash<T>> : std::true_type {};
+template <class Hash>
+inline constexpr bool sbh_default_store_hash = !sbh_is_fast_hash<Hash>::value;
+
+// ǵassignPrehashHnDBzAeubTǤJҮɤ~|إ߰
+// BzɫƨƻPƷ|bhӰPɳQIsAOw
+struct sbh_parallel_t {
+    explicit sbh_parallel_t() = default;
+};
+inline constexpr sbh_parallel_t sbh_parallel{};
+
+// 64줸k64줸
+constexpr std::uint64_t sbh_mulhi64(std::uint64_t a, std::uint64_t b) noexcept {
+#if defined(__SIZEOF_INT128__)
+    return static_cast<std::uint64_t>((static_cast<unsigned __int128>(a) * b) >> 64);
+#else
+#if defined(_MSC_VER) && defined(_M_X64)
+    if (!std::is_constant_evaluated()) {
+        return __umulh(a, b);
+    }
+#endif
+    std::uint64_t a_lo = a & 0xFFFFFFFF, a_hi = a >> 32;
+    std::uint64_t b_lo = b & 0xFFFFFFFF, b_hi = b >> 32;
+    std::uint64_t lo_lo = a_lo * b_lo;
+    std::uint64_t hi_lo = a_hi * b_lo;
+    std::uint64_t lo_hi = a_lo * b_hi;
+    std::uint64_t cross = (lo_lo >> 32) + (hi_lo & 0xFFFFFFFF) + lo_hi;
+    return a_hi * b_hi + (hi_lo >> 32) + (cross >> 32);
+#endif
+}
+
+// CPUwJpҦb֨CA䴩xWα`ƨDȮɤ
+constexpr void sbh_prefetch([[maybe_unused]] const void* p) noexcept {
+    if (std::is_constant_evaluated()) {
+        return;
+    }
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_prefetch(p);
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    _mm_prefetch(static_cast<const char*>(p), _MM_HINT_T0);
+#endif
+}
+
+// ޵AMwpѫƭȭpޡAHέǱƬOXk
+// CӵѡG
+//   round_up(n, limit)GAutoRehashɨϥΡApn̤pXkơAWLlimit
+//   valid_count(n)GAutoRehashfalseɨϥΡApnḆnXk
+//   grow(current, required)G۰XRɭnD
+//   assign(n)GƧܫIsAΨӹwpһݪ`
+//   operator()(hash_code, n)Gp
+
+// Hƨl(w])
+// Os󪬺AA|W[ejp
+struct sbh_prime_modulo {
+    static constexpr std::uint64_t primes[] = {
+        53, 97, 193, 389, 769, 1543, 3079, 6151, 12289, 24593,
+        49157, 98317, 196613, 393241, 786433, 1572869, 3145739,
+        6291469, 12582917, 25165843, 50331653, 100663319, 201326611,
+        402653189, 805306457, 1610612741, 3221225473, 4294967291,
+        6442450967, 12884901893, 25769803799, 51539607599, 103079215111,
+        206158430209, 412316860441, 824633720837, 1649267441681,
+        3298534883417, 6597069766657, 13194139533349, 26388279066671,
+        52776558133303, 105553116266509, 211106232533047, 422212465066001,
+        844424930132057, 1688849860263953, 3377699720527897, 6755399441055827,
+        13510798882111519, 27021597764223071, 54043195528445957, 108086391056891941,
+        216172782113783843, 432345564227567621, 864691128455135281, 1729382256910270481,
+        3458764513820540933, 6917529027641081903, 13835058055282163729u, 18446744073709551557u
+    };
+    static constexpr std::size_t round_up(std::size_t n, std::size_t limit) noexcept {
+        std::size_t result = 0;
+        //uʷjMU@ӽ(]dpGĥΤGj)
+        for (auto i : primes) {
+            if (i > limit) {
+                break;
+            }
+            result = static_cast<std::size_t>(i);
+            if (i >= n) {
+                break;
+            }
+        }
+        return result;
+    }
+    static constexpr std::size_t valid_count(std::size_t n) noexcept {
+        return n;
+    }
+    static constexpr std::size_t grow(std::size_t, std::size_t required) noexcept {
+        // U@ӽƤwg⭿
+        return required;
+    }
+    constexpr void assign(std::size_t) noexcept {}
+    constexpr std::size_t operator()(std::size_t hash_code, std::size_t n) const noexcept {
+        return hash_code % n;
+    }
+};
+// Psbh_prime_moduloϥάۦPƪAHwp⪺˼ƨNk(Lemire's fastmod)Aƭȷ|P|32줸
+// ˼ƨϮehX8줸
+// ƶWL32줸(ȭ64줸index)fastmodATAΤ@몺k
+struct sbh_prime_fastmod : sbh_prime_modulo {
+    std::uint64_t _reciprocal = 0;
+    constexpr void assign(std::size_t n) noexcept {
+        _reciprocal = n ? std::uint64_t(-1) / n + 1 : 0;
+    }
+    constexpr std::size_t operator()(std::size_t hash_code, std::size_t n) const noexcept {
+        std::uint32_t folded;
+        if constexpr (sizeof(std::size_t) > sizeof(std::uint32_t)) {
+            if (n > 0xFFFFFFFF) [[unlikely]] {
+                return hash_code % n;
+            }
+            folded = static_cast<std::uint32_t>(hash_code ^ (hash_code >> 32));
+        }
+        else {
+            folded = static_cast<std::uint32_t>(hash_code);
+        }
+        return static_cast<std::size_t>(sbh_mulhi64(_reciprocal * folded, n));
+    }
+};
+// Ƭ2AH줸BnNk
+// ѩstd::hash<int>ƨƳq`OơABne|VX줸PC줸
+struct sbh_power_of_two {
+    static constexpr std::size_t round_up(std::size_t n, std::size_t limit) noexcept {
+        // PlimitAקKnWL̤j2std::bit_ceil
+        return n >= std::bit_floor(limit) ? std::bit_floor(limit) : std::bit_ceil(n);
+    }
+    static constexpr std::size_t valid_count(std::size_t n) noexcept {
+        return n ? std::bit_ceil(n) : 0;
+    }
+    static constexpr std::size_t grow(std::size_t, std::size_t required) noexcept {
+        // Li2ɤwgܤ֬⭿
+        return required;
+    }
+    constexpr void assign(std::size_t) noexcept {}
+    constexpr std::size_t operator()(std::size_t hash_code, std::size_t n) const noexcept {
+        if constexpr (sizeof(std::size_t) > sizeof(std::uint32_t)) {
+            hash_code ^= hash_code >> 32;
+            hash_code *= 0x9E3779B97F4A7C15;
+            hash_code ^= hash_code >> 32;
+        }
+        else {
+            hash_code ^= hash_code >> 16;
+            hash_code *= 0x45D9F3B;
+            hash_code ^= hash_code >> 16;
+        }
+        return hash_code & (n - 1);
+    }
+};
+// Lemire's fastrangeAHkP첾NƭȬMg[0, n)AƤ
+// fastrangeuϥΫƭȪ줸A]|Wұ`ơAƨƤ]ॿ`
+struct sbh_fastrange {
+    static constexpr std::size_t round_up(std::size_t n, std::size_t limit) noexcept {
+        return (std::min)(n, limit);
+    }
+    static constexpr std::size_t valid_count(std::size_t n) noexcept {
+        return n;
+    }
+    static constexpr std::size_t grow(std::size_t current, std::size_t required) noexcept {
+        // Sƪi̴`Aۦ[HuP`Ʈɶ
+        return (std::max)(required, current * 2);
+    }
+    constexpr void assign(std::size_t) noexcept {}
+    constexpr std::size_t operator()(std::size_t hash_code, std::size_t n) const noexcept {
+        if constexpr (sizeof(std::size_t) > sizeof(std::uint32_t)) {
+            return static_cast<std::size_t>(sbh_mulhi64(hash_code * 0x9E3779B97F4A7C15, n));
+        }
+        else {
+            return static_cast<std::size_t>((std::uint64_t(hash_code * 0x9E3779B9u) * n) >> 32);
+        }
+    }
+};
+
+// @ؾާ@(jMBJβ)֭pέp
+struct sbh_probe_statistics {
+    std::size_t operations = 0;   // ާ@
+    std::size_t probes = 0;       // X`I
+    std::size_t comparisons = 0;  // Iskey_equal
+    std::size_t max_probes = 0;   // 榸ާ@X̤j`I
+};
+// stats()^Ǫַ
+// pƾubStatisticstrueɤ~|֭pA_hҬ0FhCIsɭsp
+struct sbh_statistics {
+    sbh_probe_statistics find;    // ]t妸jM
+    sbh_probe_statistics insert;  // JɷjMJ
+    sbh_probe_statistics erase;   // jMQAH_find_beforeMe@Ӹ`IX
+    std::size_t rehashes = 0;            // ]tirehash}l
+    std::size_t rehash_nanoseconds = 0;  // ]tirehashE
+    std::size_t bytes = 0;               // ثeforward_listseqP}C
+    std::size_t peak_bytes = 0;
+    std::size_t size = 0;
+    std::size_t bucket_count = 0;
+    std::size_t empty_buckets = 0;
+    std::size_t max_chain_length = 0;
+    // chain_length_histogram[k]׫ꬰkƶqA׬max_chain_length + 1
+    std::vector<std::size_t> chain_length_histogram;
+};
+
+// ǦCơAwqfrozen_single_buffer_hash_set.h
+struct sbh_serialization;
 template <
     class Key,
     class Hash = std::hash<Key>,
     class Pred = std::equal_to<Key>,
-    bool AutoRehash = true>
-//Allocator is not supported
+    class Allocator = std::allocator<Key>,
+    bool AutoRehash = true,
+    bool StoreHash = sbh_default_store_hash<Hash>,
+    class BucketPolicy = sbh_prime_modulo,
+    bool Fingerprint = false,
+    bool IncrementalRehash = false,
+    bool Statistics = false,
+    class Index = std::uint32_t,
+    bool ShrinkOnErase = false>
 class single_buffer_hash_set {
+    static_assert(AutoRehash || !IncrementalRehash, "IncrementalRehash requires AutoRehash");
+    static_assert(AutoRehash || !ShrinkOnErase, "ShrinkOnErase requires AutoRehash");
+    static_assert(std::is_unsigned_v<Index> && !std::is_same_v<Index, bool> && sizeof(Index) <= sizeof(std::size_t),
+        "Index must be an unsigned integer type no wider than std::size_t");
+    static_assert(std::is_same_v<typename std::allocator_traits<Allocator>::value_type, Key>,
+        "Allocator::value_type must be the same as Key");
+    friend struct sbh_serialization;
 public:
     using value_type = Key;
     using pointer = value_type*;
     using const_pointer = const value_type*;
     using reference = value_type&;
     using const_reference = const value_type&;
-    using size_type = std::uint32_t;
+    using size_type = Index;
     using difference_type = std::ptrdiff_t;
     using hasher = Hash;
     using key_equal = Pred;
     using key_type = Key;
+    using allocator_type = Allocator;
+    // ƨƪ^ǭȡAѹwp⫢ƭȪhϥ
+    using hash_code_type = std::size_t;
 
-    using index = std::uint32_t;
+    // PޡA]MwF`InextP}Cjp
+    // std::uint16_tAXjqpeAstd::uint64_thiHeǶWL42.9Ӥ
+    using index = Index;
     static constexpr index npos = static_cast<index>(-1);
     constexpr size_type max_size() const noexcept {
         return npos - 1;
     }
-    static constexpr size_type prime_buckets[] = {
-        53, 97, 193, 389, 769, 1543, 3079, 6151, 12289, 24593,
-        49157, 98317, 196613, 393241, 786433, 1572869, 3145739,
-        6291469, 12582917, 25165843, 50331653, 100663319, 201326611,
-        402653189, 805306457, 1610612741, 3221225473, 4294967291
-    };
+    // AutoRehashɡAebƶqWLsmall_sizeetm}CAjMuʱyforward_listsAԨREADME
+    static constexpr size_type small_size = 8;
+    static constexpr const auto& prime_buckets = sbh_prime_modulo::primes;
     constexpr size_type max_bucket_count() const noexcept {
-        return std::end(prime_buckets)[-1];
+        return static_cast<size_type>(BucketPolicy::round_up(
+            (std::numeric_limits<size_type>::max)(), (std::numeric_limits<size_type>::max)()));
     }
 private:
     // ȨѤϥΪURAIIOAstd::vector`٤@ӫ
@@ -47,89 +283,131 @@ private:
     // resizeɪơA]urehashɤ~|IsresizeAӦ¸ƤwLγB
     // FƨϥζRAmax_load_factor]QiFo
     class _index_vector {
+    public:
+        using allocator_type = typename std::allocator_traits<Allocator>::template rebind_alloc<index>;
     private:
+        using _alloc_traits = std::allocator_traits<allocator_type>;
+        static_assert(std::is_same_v<typename _alloc_traits::pointer, index*>, "fancy pointers are not supported");
         index* _ptr;
         index _size;
+        [[no_unique_address]] [[msvc::no_unique_address]] allocator_type _alloc;
     public:
         [[no_unique_address]] [[msvc::no_unique_address]]
             std::conditional_t<AutoRehash, float, std::monostate>
                 max_load_factor;
-            //ҥHgo@jӤO²檺float max_load_factorOFb32줸պABϥAutoRehashɴ4줸աAާڬ۷hæpn
-            index& operator[](index Pos) noexcept {
+            //ҥHgo@jӤO²檺float max_load_factorOFb32줸պABϥAutoRehashɬ٤U4줸աAާڬ۷hóo򥲭n
+            constexpr index& operator[](index Pos) noexcept {
                 return _ptr[Pos];
             }
-            index operator[](index Pos) const noexcept {
+            constexpr index operator[](index Pos) const noexcept {
                 return _ptr[Pos];
             }
-            auto size() const noexcept {
+            constexpr auto size() const noexcept {
                 return _size;
             }
-            index* begin() const noexcept {
+            constexpr index* begin() const noexcept {
                 return _ptr;
             }
-            index* end() const noexcept {
+            constexpr index* end() const noexcept {
                 return _ptr + _size;
             }
+            constexpr allocator_type get_allocator() const noexcept {
+                return _alloc;
+            }
             //߱ҦƨçܤjpA]SOs즳ƪݨD
-            void resize(size_type newSize) {
-                index* temp = newSize ? new index[newSize] : nullptr;
+            constexpr void resize(size_type newSize) {
+                index* temp = _allocate(newSize);
                 // SlƸƪn
-                delete[] _ptr;
+                _deallocate();
                 _ptr = temp;
                 _size = newSize;
             }
-            void clear() noexcept {
-                delete[] _ptr;
+            constexpr void clear() noexcept {
+                _deallocate();
                 _ptr = nullptr;
                 _size = 0;
             }
+            // u洫ơA洫max_load_factorF̪t۵
+            constexpr void swap_storage(_index_vector& other) noexcept {
+                assert(_alloc == other._alloc);
+                std::swap(_ptr, other._ptr);
+                std::swap(_size, other._size);
+            }
             _index_vector() = delete;
-            explicit _index_vector(size_type Size) :
-                _ptr(Size ? new index[Size] : nullptr),
-                _size(Size) {
+            explicit constexpr _index_vector(size_type Size, const allocator_type& alloc = allocator_type()) :
+                _ptr(nullptr),
+                _size(Size),
+                _alloc(alloc) {
+                _ptr = _allocate(Size);
                 if constexpr (AutoRehash) {
                     max_load_factor = 1.0;
                 }
             }
-            explicit _index_vector(size_type Size, index Val) :
-                _ptr(Size ? new index[Size] : nullptr),
-                _size(Size) {
+            explicit constexpr _index_vector(size_type Size, index Val, const allocator_type& alloc = allocator_type()) :
+                _index_vector(Size, alloc) {
                 std::fill(_ptr, _ptr + _size, Val);
-                if constexpr (AutoRehash) {
-                    max_load_factor = 1.0;
-                }
             }
-            _index_vector(const _index_vector& other) :
-                _ptr(other._size ? new index[other._size] : nullptr),
+            constexpr _index_vector(const _index_vector& other) :
+                _index_vector(other, _alloc_traits::select_on_container_copy_construction(other._alloc)) {
+            }
+            constexpr _index_vector(const _index_vector& other, const allocator_type& alloc) :
+                _ptr(nullptr),
                 _size(other._size),
+                _alloc(alloc),
                 max_load_factor(other.max_load_factor) {
+                _ptr = _allocate(other._size);
                 std::copy(other.begin(), other.end(), this->begin());
             }
-            _index_vector(_index_vector&& other) noexcept :
+            constexpr _index_vector(_index_vector&& other) noexcept :
                 _ptr(other._ptr),
                 _size(other._size),
+                _alloc(std::move(other._alloc)),
                 max_load_factor(other.max_load_factor) {
                 other._ptr = nullptr;
                 other._size = 0;
             }
-            _index_vector& operator=(const _index_vector& other) {
-                if (this->size() == other.size()) {
-                    std::copy(other.begin(), other.end(), this->begin());
+            // t۵ɵLkotherOAuƻs
+            constexpr _index_vector(_index_vector&& other, const allocator_type& alloc) :
+                _ptr(nullptr),
+                _size(other._size),
+                _alloc(alloc),
+                max_load_factor(other.max_load_factor) {
+                if (_alloc == other._alloc) {
+                    _ptr = std::exchange(other._ptr, nullptr);
+                    other._size = 0;
                 }
                 else {
-                    //ewư]ۧڽȦӵoͿ~i
-                    index* temp = other.size() ? new index[other.size()] : nullptr;//itAPªHTO`w
-                    delete[] _ptr;
-                    _ptr = temp;
-                    _size = other._size;
+                    _ptr = _allocate(_size);
                     std::copy(other.begin(), other.end(), this->begin());
                 }
-                max_load_factor = other.max_load_factor;
+            }
+            constexpr _index_vector& operator=(const _index_vector& other) {
+                if constexpr (_alloc_traits::propagate_on_container_copy_assignment::value) {
+                    if (_alloc != other._alloc) {
+                        // 즳O饲ѭ쥻t
+                        clear();
+                    }
+                    _alloc = other._alloc;
+                }
+                _copy_from(other);
                 return *this;
             }
-            _index_vector& operator=(_index_vector&& other) noexcept {
+            constexpr _index_vector& operator=(_index_vector&& other)
+                noexcept(_alloc_traits::propagate_on_container_move_assignment::value
+                    || _alloc_traits::is_always_equal::value) {
                 if (this != &other) {
-                    delete[] _ptr;
+                    if constexpr (!_alloc_traits::propagate_on_container_move_assignment::value
+                        && !_alloc_traits::is_always_equal::value) {
+                        if (_alloc != other._alloc) {
+                            // t|QǼB۵ALkotherO
+                            _copy_from(other);
+                            return *this;
+                        }
+                    }
+                    _deallocate();
+                    if constexpr (_alloc_traits::propagate_on_container_move_assignment::value) {
+                        _alloc = std::move(other._alloc);
+                    }
                     _ptr = other._ptr;
                     _size = other._size;
                     other._ptr = nullptr;
@@ -138,47 +416,125 @@ private:
                 }
                 return *this;
             }
-            ~_index_vector() noexcept {
-                delete[] _ptr;
+            constexpr ~_index_vector() noexcept {
+                _deallocate();
+            }
+    private:
+            constexpr void _copy_from(const _index_vector& other) {
+                if (this->size() == other.size()) {
+                    std::copy(other.begin(), other.end(), this->begin());
+                }
+                else {
+                    //gkw]ۧڽȦӵoͿ~i
+                    index* temp = _allocate(other.size());//itAAªHTO`w
+                    _deallocate();
+                    _ptr = temp;
+                    _size = other._size;
+                    std::copy(other.begin(), other.end(), this->begin());
+                }
+                max_load_factor = other.max_load_factor;
+            }
+            constexpr index* _allocate(size_type n) {
+                return n ? _alloc_traits::allocate(_alloc, n) : nullptr;
+            }
+            constexpr void _deallocate() noexcept {
+                if (_ptr) {
+                    _alloc_traits::deallocate(_alloc, _ptr, _size);
+                }
             }
     };
+    using _index_allocator = typename _index_vector::allocator_type;
+    // wg֨㫢ƭȮɡAS@
+    static constexpr bool _store_fingerprint = Fingerprint && !StoreHash;
     //`I
     struct Node {
         value_type payload;
         index next;//VU@Ӹ`I 
         //zLϥίަӤOpointeriHTOYKhwİϤwʡA]έsվnext
         //åBindexb64줸ҦUϥΤpointer֤@bO
-        Node(const value_type& value, index Next)
+        //StoreHashɧ֨㪺ƭȡArehashPɫKspAXɤ]ƭȦAIskey_equal
+        [[no_unique_address]] [[msvc::no_unique_address]]
+            std::conditional_t<StoreHash, std::size_t, std::monostate> hash_code;
+        //Fingerprintxs8줸ƫAq`inext᪺RAW[`Ijp
+        //PnextP@֨CAXɥiHHưj۲Ū`IAӤIskey_equal
+        [[no_unique_address]] [[msvc::no_unique_address]]
+            std::conditional_t<_store_fingerprint, std::uint8_t, std::monostate> fingerprint;
+        constexpr Node(const value_type& value, index Next, std::size_t Hash_code)
             noexcept(noexcept(value_type(std::declval<const value_type&>())))
             :payload(value), next(Next) {
+            set_hash(Hash_code);
         }
-        Node(value_type&& value, index Next)
+        constexpr Node(value_type&& value, index Next, std::size_t Hash_code)
             noexcept(noexcept(value_type(std::declval<value_type&&>())))
             :payload(std::move(value)), next(Next) {
+            set_hash(Hash_code);
+        }
+        constexpr void set_hash([[maybe_unused]] std::size_t Hash_code) noexcept {
+            if constexpr (StoreHash) {
+                hash_code = Hash_code;
+            }
+            if constexpr (_store_fingerprint) {
+                fingerprint = _fingerprint_of(Hash_code);
+            }
         }
-        //غcƤ\ϥpayloadغcưѼƫغcNodeAemplaceϥ
-#pragma warning(push)
-#pragma warning(disable: 26495)
-//غcƥlƦܼnextALѩNodeOpcAӨCөIsغcƪa賣blnextAξPNodeAG]SwΡulƦvĵi
-//ߤ@ϥΦغcƪaO_index_emplace
-        template <typename... Args>
-        explicit Node(Args&&... args)
-            noexcept(noexcept(value_type(std::forward<Args>(args)...)))
-            :payload(std::forward<Args>(args)...) {
-        }
-#pragma warning(pop)
     };
     // OƦ
-    std::vector<Node> forward_lists; //ѳ@wİϩҺcV쵲C
+    using _node_allocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Node>;
+    std::vector<Node, _node_allocator> forward_lists; //ѳ@wİϩҺcV쵲C
     // xsVUӱ}Y
     // ~AFƨϥζRAmax_load_factor]QiF_index_vector̭
     _index_vector buckets;
     // [[no_unique_address]]ثebMSVCWSĪG
     [[no_unique_address]] [[msvc::no_unique_address]] hasher hash;     // ƨ
     [[no_unique_address]] [[msvc::no_unique_address]] key_equal equal; // 
+    [[no_unique_address]] [[msvc::no_unique_address]] BucketPolicy bucket_policy; // ޵wp⪺`
+    // ۰Yp}Ct]leA0ܤYp
+    // Pmax_load_factorAi_index_vector|irehash±]ha@A]Wߦs
+    // _index_vectorbw]32줸indexUSRiΡA]uShrinkOnErasetrueɤ~ΪŶ
+    struct _no_min_load_factor {};
+    [[no_unique_address]] [[msvc::no_unique_address]]
+        std::conditional_t<ShrinkOnErase, float, _no_min_load_factor> minimum_load_factor{};
+    // irehashɩ|E±
+    // ±[0, cursor)wEbucketsAl걵b±W
+    // JɡAYݪ±|EAhJ±A_hJsA]Cui@
+    struct _migration {
+        _index_vector old_buckets;
+        [[no_unique_address]] [[msvc::no_unique_address]] BucketPolicy old_policy;
+        index cursor = 0;
+    };
+    [[no_unique_address]] [[msvc::no_unique_address]]
+        std::conditional_t<IncrementalRehash, _migration, std::monostate> migration;
+    // Statisticsɲ֭ppƾ
+    // jMOconst禡A]pƾOmutableAo]NhӰPɷjMP@Ӯe
+    struct _counters {
+        sbh_probe_statistics find;
+        sbh_probe_statistics insert;
+        sbh_probe_statistics erase;
+        std::size_t rehashes = 0;
+        std::size_t rehash_nanoseconds = 0;
+        std::size_t peak_bytes = 0;
+    };
+    // ҥήɨϥοWߪOAYPmigrationPstd::monostateA̵Lk@Φ}ӷ|W[ejp
+    struct _no_counters {};
+    using _probe_counter = std::conditional_t<Statistics, sbh_probe_statistics, _no_counters>;
+    [[no_unique_address]] [[msvc::no_unique_address]]
+        mutable std::conditional_t<Statistics, _counters, _no_counters> statistics;
+    // PC++20LǮeۦPAubHashPPredҬtransparentɤ~ҥβd
+    static constexpr bool _is_transparent = requires {
+        typename Hash::is_transparent;
+        typename Pred::is_transparent;
+    };
+    // غcNHargjMGargNOAάOzdiΪ
+    template <class Arg>
+    static constexpr bool _is_lookup_arg = std::is_same_v<std::remove_cvref_t<Arg>, value_type>
+        || (_is_transparent && std::is_constructible_v<value_type, Arg&&>
+            && std::is_invocable_v<const Hash&, const std::remove_cvref_t<Arg>&>
+            && std::is_invocable_r_v<bool, const Pred&, const std::remove_cvref_t<Arg>&, const value_type&>);
+    template <class... Args>
+    static constexpr bool _emplace_as_key = sizeof...(Args) == 1 && (_is_lookup_arg<Args> && ...);
 public:
     class const_iterator {
-        std::vector<Node>::const_iterator _iter;
+        typename std::vector<Node, _node_allocator>::const_iterator _iter;
     public:
         using iterator_concept = std::random_access_iterator_tag;
         using iterator_category = std::random_access_iterator_tag;
@@ -187,54 +543,54 @@ public:
         using distance_type = std::ptrdiff_t;
         using pointer = const value_type*;
         using reference = const value_type&;
-        const_iterator(std::vector<Node>::const_iterator it) noexcept :_iter(it) {};
-        const_iterator() noexcept {};
-        [[nodiscard]] const_reference operator*() const noexcept {
+        constexpr const_iterator(typename std::vector<Node, _node_allocator>::const_iterator it) noexcept :_iter(it) {};
+        constexpr const_iterator() noexcept {};
+        [[nodiscard]] constexpr const_reference operator*() const noexcept {
             return _iter->payload;
         }
-        [[nodiscard]] const_pointer operator->() const noexcept {
+        [[nodiscard]] constexpr const_pointer operator->() const noexcept {
             return std::addressof(_iter->payload);
         }
-        [[nodiscard]] const_reference operator[](const difference_type offset) const noexcept {
+        [[nodiscard]] constexpr const_reference operator[](const difference_type offset) const noexcept {
             return _iter[offset].payload;
         }
-        const_iterator& operator++() noexcept {
+        constexpr const_iterator& operator++() noexcept {
             ++_iter;
             return *this;
         }
-        const_iterator operator++(int) noexcept {
+        constexpr const_iterator operator++(int) noexcept {
             const_iterator temp = *this;
             ++*this;
             return temp;
         }
-        const_iterator& operator--() noexcept {
+        constexpr const_iterator& operator--() noexcept {
             --_iter;
             return *this;
         }
-        const_iterator operator--(int) noexcept {
+        constexpr const_iterator operator--(int) noexcept {
             const_iterator temp = *this;
             --*this;
             return temp;
         }
-        const_iterator& operator+=(const difference_type offset) noexcept {
+        constexpr const_iterator& operator+=(const difference_type offset) noexcept {
             _iter += offset;
             return *this;
         }
-        [[nodiscard]] const_iterator operator+(const difference_type offset) const noexcept {
+        [[nodiscard]] constexpr const_iterator operator+(const difference_type offset) const noexcept {
             return const_iterator(_iter + offset);
         }
-        [[nodiscard]] friend const_iterator operator+(
+        [[nodiscard]] friend constexpr const_iterator operator+(
             const difference_type offset, const_iterator right) noexcept {
             return right + offset;
         }
-        const_iterator& operator-=(const difference_type offset) noexcept {
+        constexpr const_iterator& operator-=(const difference_type offset) noexcept {
             _iter -= offset;
             return *this;
         }
-        [[nodiscard]] const_iterator operator-(const difference_type offset) const noexcept {
+        [[nodiscard]] constexpr const_iterator operator-(const difference_type offset) const noexcept {
             return const_iterator(_iter - offset);
         }
-        [[nodiscard]] difference_type operator-(const const_iterator& other) const noexcept {
+        [[nodiscard]] constexpr difference_type operator-(const const_iterator& other) const noexcept {
             return _iter - other._iter;
         }
         [[nodiscard]] bool operator==(const const_iterator&) const noexcept = default;
@@ -245,58 +601,110 @@ public:
     using const_reverse_iterator = std::reverse_iterator<const_iterator>;
     using reverse_iterator = const_reverse_iterator;
 
-    [[nodiscard]] const_iterator begin() const noexcept {
+    [[nodiscard]] constexpr const_iterator begin() const noexcept {
         return const_iterator(forward_lists.begin());
     }
-    [[nodiscard]] const_iterator cbegin() const noexcept {
+    [[nodiscard]] constexpr const_iterator cbegin() const noexcept {
         return begin();
     }
-    [[nodiscard]] const_iterator end() const noexcept {
+    [[nodiscard]] constexpr const_iterator end() const noexcept {
         return const_iterator(forward_lists.end());
     }
-    [[nodiscard]] const_iterator cend() const noexcept {
+    [[nodiscard]] constexpr const_iterator cend() const noexcept {
         return end();
     }
-    [[nodiscard]] const_reverse_iterator rbegin() const noexcept {
+    [[nodiscard]] constexpr const_reverse_iterator rbegin() const noexcept {
         return const_reverse_iterator(end());
     }
-    [[nodiscard]] const_reverse_iterator rcbegin() const noexcept {
+    [[nodiscard]] constexpr const_reverse_iterator rcbegin() const noexcept {
         return rbegin();
     }
-    [[nodiscard]] const_reverse_iterator rend() const noexcept {
+    [[nodiscard]] constexpr const_reverse_iterator rend() const noexcept {
         return const_reverse_iterator(begin());
     }
-    [[nodiscard]] const_reverse_iterator rcend() const noexcept {
+    [[nodiscard]] constexpr const_reverse_iterator rcend() const noexcept {
         return rend();
     }
 
     // غc禡
     // ۰ʺ޲z
-    explicit single_buffer_hash_set(size_type bucket_count = 53, size_type initialCapacity = 0, const hasher& hashFunction = hasher(), const key_equal& equalFunction = key_equal())
+    // bucket_count0ɥHpҦ}lAغcɤtmO
+    explicit constexpr single_buffer_hash_set(size_type bucket_count = 0, size_type initialCapacity = 0, const hasher& hashFunction = hasher(), const key_equal& equalFunction = key_equal(), const allocator_type& alloc = allocator_type())
         requires AutoRehash
-    : buckets(0), hash(hashFunction), equal(equalFunction) {
+    : forward_lists(_node_allocator(alloc)), buckets(0, _index_allocator(alloc)), hash(hashFunction), equal(equalFunction), migration(_make_migration(alloc)) {
         forward_lists.reserve(initialCapacity);
         rehash(bucket_count);
     }
+    explicit constexpr single_buffer_hash_set(const allocator_type& alloc)
+        requires AutoRehash
+    : single_buffer_hash_set(0, 0, hasher(), key_equal(), alloc) {
+    }
     // ʺ޲zAbغc禡Xlƶq
     // The initial number of buckets must be given explicitly
-    explicit single_buffer_hash_set(size_type bucket_count, size_type initialCapacity = 0, const hasher& hashFunction = hasher(), const key_equal& equalFunction = key_equal())
+    explicit constexpr single_buffer_hash_set(size_type bucket_count, size_type initialCapacity = 0, const hasher& hashFunction = hasher(), const key_equal& equalFunction = key_equal(), const allocator_type& alloc = allocator_type())
         requires (!AutoRehash)
-    : buckets(bucket_count, npos), hash(hashFunction), equal(equalFunction) {
+    : forward_lists(_node_allocator(alloc)), buckets(static_cast<size_type>(BucketPolicy::valid_count(bucket_count)), npos, _index_allocator(alloc)), hash(hashFunction), equal(equalFunction) {
+        bucket_policy.assign(buckets.size());
         forward_lists.reserve(initialCapacity);
     }
+    // Hd[first, last)غcAԨassign
+    template <std::input_iterator InputIt, std::sentinel_for<InputIt> Sentinel>
+    constexpr single_buffer_hash_set(InputIt first, Sentinel last, size_type bucket_count = 0, const hasher& hashFunction = hasher(), const key_equal& equalFunction = key_equal(), const allocator_type& alloc = allocator_type())
+        requires (AutoRehash)
+    : single_buffer_hash_set(bucket_count, 0, hashFunction, equalFunction, alloc) {
+        assign(first, last);
+    }
+    template <std::input_iterator InputIt, std::sentinel_for<InputIt> Sentinel>
+    constexpr single_buffer_hash_set(InputIt first, Sentinel last, size_type bucket_count, const hasher& hashFunction = hasher(), const key_equal& equalFunction = key_equal(), const allocator_type& alloc = allocator_type())
+        requires (!AutoRehash)
+    : single_buffer_hash_set(bucket_count, 0, hashFunction, equalFunction, alloc) {
+        assign(first, last);
+    }
+    // HwtƻsβʡAt۵ɲʷ|hƬv@ʤ
+    constexpr single_buffer_hash_set(const single_buffer_hash_set& other, const allocator_type& alloc)
+    : forward_lists(other.forward_lists, _node_allocator(alloc)), buckets(other.buckets, _index_allocator(alloc)),
+        hash(other.hash), equal(other.equal), bucket_policy(other.bucket_policy), minimum_load_factor(other.minimum_load_factor),
+        migration(_migration_with(other.migration, alloc)), statistics(other.statistics) {
+    }
+    constexpr single_buffer_hash_set(single_buffer_hash_set&& other, const allocator_type& alloc)
+    : forward_lists(std::move(other.forward_lists), _node_allocator(alloc)), buckets(std::move(other.buckets), _index_allocator(alloc)),
+        hash(std::move(other.hash)), equal(std::move(other.equal)), bucket_policy(other.bucket_policy), minimum_load_factor(other.minimum_load_factor),
+        migration(_migration_with(std::move(other.migration), alloc)), statistics(other.statistics) {
+    }
+    single_buffer_hash_set(const single_buffer_hash_set&) = default;
+    single_buffer_hash_set(single_buffer_hash_set&&) = default;
+    single_buffer_hash_set& operator=(const single_buffer_hash_set&) = default;
+    single_buffer_hash_set& operator=(single_buffer_hash_set&&) = default;
+    [[nodiscard]] constexpr allocator_type get_allocator() const noexcept {
+        return allocator_type(forward_lists.get_allocator());
+    }
 
-    // p⫢Ʊ
-    [[nodiscard]] size_type bucket(const key_type& value) const
+    // p⫢ƱޡApҦUSA^0
+    [[nodiscard]] constexpr size_type bucket(const key_type& value) const
         noexcept(noexcept(hash(std::declval<key_type>()))) {
-        assert(buckets.size() > 0);
-        return hash(value) % buckets.size();
+        if (_is_small()) {
+            return 0;
+        }
+        return _bucket_of_hash(hash(value));
+    }
+    template <class K>
+        requires _is_transparent
+    [[nodiscard]] constexpr size_type bucket(const K& value) const
+        noexcept(noexcept(hash(std::declval<const K&>()))) {
+        if (_is_small()) {
+            return 0;
+        }
+        return _bucket_of_hash(hash(value));
     }
-    [[nodiscard]] size_type bucket_count() const noexcept {
+    [[nodiscard]] constexpr size_type bucket_count() const noexcept {
         return buckets.size();
     }
-    [[nodiscard]] size_type bucket_size(size_type nbucket) const noexcept {
-        assert(nbucket < size());
+    // irehashi椤ɡAupwEܷsFpҦUSA^0
+    [[nodiscard]] constexpr size_type bucket_size(size_type nbucket) const noexcept {
+        if (_is_small()) {
+            return 0;
+        }
+        assert(nbucket < bucket_count());
         index now = buckets[nbucket];
         size_type i = 0;
         while (now != npos) {
@@ -305,10 +713,14 @@ public:
         }
         return i;
     }
-    [[nodiscard]] float load_factor() const noexcept {
+    // pҦUSA^0
+    [[nodiscard]] constexpr float load_factor() const noexcept {
+        if (_is_small()) {
+            return 0;
+        }
         return float(size()) / (float)bucket_count();
     }
-    [[nodiscard]] float max_load_factor() const noexcept {
+    [[nodiscard]] constexpr float max_load_factor() const noexcept {
         if constexpr (AutoRehash) {
             return buckets.max_load_factor;
         }
@@ -316,32 +728,54 @@ public:
             return std::numeric_limits<float>::infinity();
         }
     };
-    void max_load_factor(float factor) noexcept
+    constexpr void max_load_factor(float factor) noexcept
         requires AutoRehash {
         buckets.max_load_factor = factor;
     }
-    [[nodiscard]] size_type size() const noexcept {
+    // t]lCmin_load_factorɡA۰ʱNYpܨϭt]lmax_load_factor@b
+    // ڨϥΪeWLmax_load_factor|@AYpݭnAJ@~|AXiA|berehash
+    // w]0AYPstd::unordered_setۦPAƥû|۰ʴ֡FShrinkOnErasefalseɩTw0
+    [[nodiscard]] constexpr float min_load_factor() const noexcept {
+        if constexpr (ShrinkOnErase) {
+            return minimum_load_factor;
+        }
+        else {
+            return 0;
+        }
+    }
+    constexpr void min_load_factor(float factor) noexcept
+        requires ShrinkOnErase {
+        minimum_load_factor = factor;
+    }
+    [[nodiscard]] constexpr size_type size() const noexcept {
         return static_cast<size_type>(forward_lists.size());
     }
-    [[nodiscard]] bool empty() const noexcept {
+    [[nodiscard]] constexpr bool empty() const noexcept {
         return forward_lists.empty();
     }
-    void rehash(size_type nbuckets) {
+    constexpr void rehash(size_type nbuckets) {
+        _rehash(nbuckets, false);
+    }
+    // PrehashۦPAƶqܤ֬_parallel_thresholdɥHhӰs걵AGP`ǪۦP
+    void rehash(sbh_parallel_t, size_type nbuckets) {
+        _rehash(nbuckets, true);
+    }
+    constexpr void _rehash(size_type nbuckets, bool parallel) {
         if constexpr (AutoRehash) {
             // don't violate a.bucket_count() >= a.size() / a.max_load_factor() invariant:
-            nbuckets = (std::max)(nbuckets, static_cast<size_type>(size() / max_load_factor()));
+            nbuckets = (std::max)(nbuckets, _bucket_count_for(size()));
             if (nbuckets <= bucket_count()) {
                 return;// we already have enough buckets; nothing to do
             }
-            //uʷjMU@ӽ(]dpGĥΤGj)
-            for (auto i : prime_buckets) {
-                if (i >= nbuckets) {
-                    nbuckets = i;
-                    break;
-                }
-            }
+            nbuckets = static_cast<size_type>(BucketPolicy::round_up(nbuckets, max_bucket_count()));
         }
-        buckets.resize(nbuckets);
+        else {
+            nbuckets = static_cast<size_type>(BucketPolicy::valid_count(nbuckets));
+        }
+        [[maybe_unused]] auto timer = _time_rehash();
+        _resize_buckets(nbuckets);
+        // 㪺rehash|s걵ҦA|E±wAݭn
+        _discard_migration();
         if constexpr (!AutoRehash) {
             if (nbuckets == 0) {
                 return;
@@ -349,203 +783,1721 @@ public:
                 //\Isd/J/ơArehashPclearHdestroy_container~
             }
         }
-        std::fill(buckets.begin(), buckets.end(), npos);
-        size_type i = 0;
-        for (auto& node : forward_lists) {
-            index temp = bucket(node.payload);
-            node.next = buckets[temp];
-            buckets[temp] = i;
-            ++i;
-        }
+        _relink(parallel);
     }
     //wOdΩs񤸯O
-    //AutoRehashɡA]|@ּW[
-    void reserve(size_type newcapacity) {
+    //AutoRehashɡA]|@ּW[ơFpҦUnewcapacityWLsmall_sizeɺpҦ
+    constexpr void reserve(size_type newcapacity) {
         forward_lists.reserve(newcapacity);
+        _record_memory();
         if constexpr (AutoRehash) {
-            rehash(static_cast<size_type>((newcapacity + 8) / max_load_factor()));
+            _reserve_buckets(newcapacity);
         }
     }
-    size_type capacity() const noexcept {
+    constexpr size_type capacity() const noexcept {
         return static_cast<size_type>(forward_lists.capacity());
     }
-    void clear() noexcept {
+    constexpr void clear() noexcept {
         forward_lists.clear();
         std::fill(buckets.begin(), buckets.end(), npos);
+        _discard_migration();
     }
     void shrink_to_fit() {
         forward_lists.shrink_to_fit();
     }
+    // Nforward_listsP}CYpܥثeƶqһݪ̤pȡAypɴdUO
+    // ƬWLmax_load_factor̤pĭȡA]U@JܥiN|ĲorehashAAXbeAjqJɩIs
+    // ƶqWLsmall_sizeӱ}CA^pҦ
+    // AutoRehashfalseɱƥѨϥΪ̺޲zAuYpforward_lists
+    void compact() {
+        forward_lists.shrink_to_fit();
+        _record_memory();
+        if constexpr (AutoRehash) {
+            size_type nbuckets = _smallest_bucket_count(size());
+            if (size() <= small_size) {
+                if (!_is_small()) {
+                    _resize_buckets(0);
+                    _discard_migration();
+                    _link_small();
+                }
+            }
+            else if (nbuckets < bucket_count()) {
+                [[maybe_unused]] auto timer = _time_rehash();
+                _resize_buckets(nbuckets);
+                _discard_migration();
+                _relink();
+            }
+            else if constexpr (IncrementalRehash) {
+                finish_rehash();
+            }
+        }
+    }
     //eϥΪҦ귽AϮeB󤣥iϥΦӥiBRcƪAC
-    void destroy_container() noexcept {
+    //AutoRehashɮe|^pҦAMiH~ϥ
+    constexpr void destroy_container() noexcept {
         forward_lists.clear();
         forward_lists.shrink_to_fit();
         buckets.clear();
+        bucket_policy.assign(0);
+        _discard_migration();
+    }
+    // irehashO_bi
+    [[nodiscard]] constexpr bool rehash_in_progress() const noexcept {
+        if constexpr (IncrementalRehash) {
+            return migration.old_buckets.size() != 0;
+        }
+        else {
+            return false;
+        }
+    }
+    // ߧYi椤irehash
+    constexpr void finish_rehash()
+        noexcept(noexcept(_hash_of(std::declval<const Node&>())))
+        requires IncrementalRehash {
+        if (rehash_in_progress()) {
+            _migrate_buckets(migration.old_buckets.size());
+        }
+    }
+    // έpTַ
+    // pƾubStatisticstrueɤ~|֭pFתC|spAݭnXҦP
+    // irehashi椤ɡA|E±]|QpJ
+    [[nodiscard]] sbh_statistics stats() const {
+        sbh_statistics result;
+        if constexpr (Statistics) {
+            result.find = statistics.find;
+            result.insert = statistics.insert;
+            result.erase = statistics.erase;
+            result.rehashes = statistics.rehashes;
+            result.rehash_nanoseconds = statistics.rehash_nanoseconds;
+        }
+        result.bytes = _memory_usage();
+        result.peak_bytes = result.bytes;
+        if constexpr (Statistics) {
+            result.peak_bytes = (std::max)(result.peak_bytes, statistics.peak_bytes);
+        }
+        result.size = size();
+        result.bucket_count = bucket_count();
+        auto& histogram = result.chain_length_histogram;
+        auto count_chains = [&](const _index_vector& heads, std::size_t first) {
+            for (std::size_t b = first; b < heads.size(); ++b) {
+                std::size_t length = 0;
+                for (index now = heads[static_cast<index>(b)]; now != npos; now = forward_lists[now].next) {
+                    ++length;
+                }
+                if (length >= histogram.size()) {
+                    histogram.resize(length + 1, 0);
+                }
+                ++histogram[length];
+            }
+        };
+        count_chains(buckets, 0);
+        if constexpr (IncrementalRehash) {
+            if (rehash_in_progress()) {
+                count_chains(migration.old_buckets, migration.cursor);
+            }
+        }
+        if (!histogram.empty()) {
+            result.empty_buckets = histogram[0];
+            result.max_chain_length = histogram.size() - 1;
+        }
+        return result;
+    }
+    // NpƾksAåHثeOζq@sp
+    void reset_stats() noexcept
+        requires Statistics {
+        statistics = _counters();
+        statistics.peak_bytes = _memory_usage();
     }
 
-    [[nodiscard]] index _index_find(const key_type& keyval)
-        const noexcept(noexcept(_index_find_impl(std::declval<key_type>(), 0))) {
-        return _index_find_impl(keyval, bucket(keyval));
+    [[nodiscard]] constexpr index _index_find(const key_type& keyval)
+        const noexcept(noexcept(_index_find_hetero(std::declval<key_type>()))) {
+        return _index_find_hetero(keyval);
     }
-    [[nodiscard]] const_iterator find(const key_type& keyval)
+    [[nodiscard]] constexpr const_iterator find(const key_type& keyval)
         const noexcept(noexcept(_index_find(std::declval<key_type>()))) {
         index temp = _index_find(keyval);
         return temp == npos ?
             end() :
             begin() + temp;
     }
-    [[nodiscard]] size_type count(const key_type& key)
+    [[nodiscard]] constexpr size_type count(const key_type& key)
         const noexcept(noexcept(_index_find(std::declval<value_type>()))) {
         return _index_find(key) != npos;
     }
-    [[nodiscard]] bool contains(const key_type& key)
+    [[nodiscard]] constexpr bool contains(const key_type& key)
         const noexcept(noexcept(count(std::declval<value_type>()))) {
         return count(key);
     }
+    // dAҦpHstd::string_viewjMstd::stringӤغcȮɪ
+    template <class K>
+        requires _is_transparent
+    [[nodiscard]] constexpr index _index_find(const K& keyval)
+        const noexcept(noexcept(_index_find_hetero(std::declval<const K&>()))) {
+        return _index_find_hetero(keyval);
+    }
+    template <class K>
+        requires _is_transparent
+    [[nodiscard]] constexpr const_iterator find(const K& keyval)
+        const noexcept(noexcept(_index_find_hetero(std::declval<const K&>()))) {
+        index temp = _index_find_hetero(keyval);
+        return temp == npos ?
+            end() :
+            begin() + temp;
+    }
+    template <class K>
+        requires _is_transparent
+    [[nodiscard]] constexpr size_type count(const K& key)
+        const noexcept(noexcept(_index_find_hetero(std::declval<const K&>()))) {
+        return _index_find_hetero(key) != npos;
+    }
+    template <class K>
+        requires _is_transparent
+    [[nodiscard]] constexpr bool contains(const K& key)
+        const noexcept(noexcept(_index_find_hetero(std::declval<const K&>()))) {
+        return _index_find_hetero(key) != npos;
+    }
+    // Hwp⪺ƭȷjMAhash_codehash_function()(key)
+    // HP@ӫƨƷjMhӮeɡACuݭp@ƭ
+    [[nodiscard]] constexpr index _index_find(const key_type& keyval, hash_code_type hash_code)
+        const noexcept(noexcept(_index_find_prehashed(std::declval<key_type>(), 0))) {
+        return _index_find_prehashed(keyval, hash_code);
+    }
+    [[nodiscard]] constexpr const_iterator find(const key_type& keyval, hash_code_type hash_code)
+        const noexcept(noexcept(_index_find_prehashed(std::declval<key_type>(), 0))) {
+        index temp = _index_find_prehashed(keyval, hash_code);
+        return temp == npos ?
+            end() :
+            begin() + temp;
+    }
+    [[nodiscard]] constexpr bool contains(const key_type& key, hash_code_type hash_code)
+        const noexcept(noexcept(_index_find_prehashed(std::declval<key_type>(), 0))) {
+        return _index_find_prehashed(key, hash_code) != npos;
+    }
+    template <class K>
+        requires _is_transparent
+    [[nodiscard]] constexpr index _index_find(const K& keyval, hash_code_type hash_code)
+        const noexcept(noexcept(_index_find_prehashed(std::declval<const K&>(), 0))) {
+        return _index_find_prehashed(keyval, hash_code);
+    }
+    template <class K>
+        requires _is_transparent
+    [[nodiscard]] constexpr const_iterator find(const K& keyval, hash_code_type hash_code)
+        const noexcept(noexcept(_index_find_prehashed(std::declval<const K&>(), 0))) {
+        index temp = _index_find_prehashed(keyval, hash_code);
+        return temp == npos ?
+            end() :
+            begin() + temp;
+    }
+    template <class K>
+        requires _is_transparent
+    [[nodiscard]] constexpr bool contains(const K& key, hash_code_type hash_code)
+        const noexcept(noexcept(_index_find_prehashed(std::declval<const K&>(), 0))) {
+        return _index_find_prehashed(key, hash_code) != npos;
+    }
+    // ƭȡAStoreHashɪΧ֨ȡA_hsp
+    [[nodiscard]] constexpr hash_code_type _index_hash_code(index Where) const
+        noexcept(noexcept(_hash_of(std::declval<const Node&>()))) {
+        assert(Where < size());
+        return _hash_of(forward_lists[Where]);
+    }
+    [[nodiscard]] constexpr hash_code_type hash_code(const_iterator Where) const
+        noexcept(noexcept(_hash_of(std::declval<const Node&>()))) {
+        return _index_hash_code(static_cast<index>(Where - begin()));
+    }
+    // ̭NǨX(, ƭ)AƭȪo覡Phash_codeۦP
+    // iHNƭȪ浹t@ӨϥάۦPƨƪeAӤsp
+    [[nodiscard]] auto with_hash_codes() const noexcept {
+        return forward_lists | std::views::transform([this](const Node& node) {
+            return std::pair<const value_type&, hash_code_type>(node.payload, _hash_of(node));
+        });
+    }
+
+    // 妸jMA̧ǱN[first, last)C䪺jMGgJout
+    // CBz@Gp⫢ƭȨùwAAwUĤ@Ӹ`IA̫~X
+    // p@ӦU䪺֨RiHۭ|AӤv@
+    template <std::forward_iterator InputIt, std::sentinel_for<InputIt> Sentinel, class OutputIt>
+    OutputIt _index_find_many(InputIt first, Sentinel last, OutputIt out) const {
+        std::size_t hash_codes[_batch_size];
+        index heads[_batch_size];
+        while (first != last) {
+            InputIt group_first = first;
+            size_type n = _prefetch_group(first, last, hash_codes, heads);
+            for (size_type i = 0; i < n; ++i, ++group_first) {
+                *out = _index_find_from(*group_first, hash_codes[i], heads[i], _find_counter());
+                ++out;
+            }
+        }
+        return out;
+    }
+    template <std::forward_iterator InputIt, std::sentinel_for<InputIt> Sentinel, class OutputIt>
+    OutputIt find_many(InputIt first, Sentinel last, OutputIt out) const {
+        std::size_t hash_codes[_batch_size];
+        index heads[_batch_size];
+        while (first != last) {
+            InputIt group_first = first;
+            size_type n = _prefetch_group(first, last, hash_codes, heads);
+            for (size_type i = 0; i < n; ++i, ++group_first) {
+                index temp = _index_find_from(*group_first, hash_codes[i], heads[i], _find_counter());
+                *out = temp == npos ?
+                    end() :
+                    begin() + temp;
+                ++out;
+            }
+        }
+        return out;
+    }
+    template <std::forward_iterator InputIt, std::sentinel_for<InputIt> Sentinel, class OutputIt>
+    OutputIt contains_many(InputIt first, Sentinel last, OutputIt out) const {
+        std::size_t hash_codes[_batch_size];
+        index heads[_batch_size];
+        while (first != last) {
+            InputIt group_first = first;
+            size_type n = _prefetch_group(first, last, hash_codes, heads);
+            for (size_type i = 0; i < n; ++i, ++group_first) {
+                *out = _index_find_from(*group_first, hash_codes[i], heads[i], _find_counter()) != npos;
+                ++out;
+            }
+        }
+        return out;
+    }
 
-    std::pair<index, bool> _index_insert(const value_type& value) {
+    constexpr std::pair<index, bool> _index_insert(const value_type& value) {
         return _index_insert_impl(value);
     }
-    std::pair<index, bool> _index_insert(value_type&& value) {
+    constexpr std::pair<index, bool> _index_insert(value_type&& value) {
         return _index_insert_impl(std::move(value));
     }
-    std::pair<const_iterator, bool> insert(const value_type& value) {
+    constexpr std::pair<const_iterator, bool> insert(const value_type& value) {
         auto temp = _index_insert(value);
         return { begin() + temp.first,temp.second };
     }
-    std::pair<const_iterator, bool> insert(value_type&& value) {
+    constexpr std::pair<const_iterator, bool> insert(value_type&& value) {
         auto temp = _index_insert(std::move(value));
         return { begin() + temp.first,temp.second };
     }
-    template <class... Args>
-    std::pair<index, bool> _index_emplace(Args&&... args) {
-        if constexpr (AutoRehash) {
-            _check_rehash_required_1();
+    // 贡JAubsbɤ~|Hvalueغcs
+    template <class K>
+        requires (_is_transparent
+            && std::is_constructible_v<value_type, K&&>
+            && !std::is_same_v<std::remove_cvref_t<K>, value_type>
+            && !std::is_convertible_v<K&&, const_iterator>)
+    constexpr std::pair<index, bool> _index_insert(K&& value) {
+        return _index_insert_impl(std::forward<K>(value));
+    }
+    template <class K>
+        requires (_is_transparent
+            && std::is_constructible_v<value_type, K&&>
+            && !std::is_same_v<std::remove_cvref_t<K>, value_type>
+            && !std::is_convertible_v<K&&, const_iterator>)
+    constexpr std::pair<const_iterator, bool> insert(K&& value) {
+        auto temp = _index_insert_impl(std::forward<K>(value));
+        return { begin() + temp.first,temp.second };
+    }
+    // Hwp⪺ƭȴJAhash_codehash_function()(value)
+    constexpr std::pair<index, bool> _index_insert(const value_type& value, hash_code_type hash_code) {
+        assert(hash_code == hash(value));
+        return _index_insert_hashed(value, hash_code);
+    }
+    constexpr std::pair<index, bool> _index_insert(value_type&& value, hash_code_type hash_code) {
+        assert(hash_code == hash(value));
+        return _index_insert_hashed(std::move(value), hash_code);
+    }
+    constexpr std::pair<const_iterator, bool> insert(const value_type& value, hash_code_type hash_code) {
+        auto temp = _index_insert(value, hash_code);
+        return { begin() + temp.first,temp.second };
+    }
+    constexpr std::pair<const_iterator, bool> insert(value_type&& value, hash_code_type hash_code) {
+        auto temp = _index_insert(std::move(value), hash_code);
+        return { begin() + temp.first,temp.second };
+    }
+    template <class K>
+        requires (_is_transparent
+            && std::is_constructible_v<value_type, K&&>
+            && !std::is_same_v<std::remove_cvref_t<K>, value_type>)
+    constexpr std::pair<index, bool> _index_insert(K&& value, hash_code_type hash_code) {
+        assert(hash_code == hash(value));
+        return _index_insert_hashed(std::forward<K>(value), hash_code);
+    }
+    template <class K>
+        requires (_is_transparent
+            && std::is_constructible_v<value_type, K&&>
+            && !std::is_same_v<std::remove_cvref_t<K>, value_type>)
+    constexpr std::pair<const_iterator, bool> insert(K&& value, hash_code_type hash_code) {
+        auto temp = _index_insert(std::forward<K>(value), hash_code);
+        return { begin() + temp.first,temp.second };
+    }
+    // H[first, last)NeeAƪuOdĤ@ӡAƦCǻPv@JɬۦP
+    template <std::input_iterator InputIt, std::sentinel_for<InputIt> Sentinel>
+    constexpr void assign(InputIt first, Sentinel last) {
+        clear();
+        insert_range(std::ranges::subrange(first, last));
+    }
+    // PassignۦPA󤸯ƶqWL_parallel_thresholdHsdA|HhӰغcG
+    // 1. pCӤƭȻP
+    // 2. ̱ުdN(íwpƱƧ)
+    // 3. CӰtd@q|A̿JǦ걵òƪ
+    // 4. HeMpCӫOdUӪ̲ׯޡAƻsíץnextP
+    template <std::input_iterator InputIt, std::sentinel_for<InputIt> Sentinel>
+    void assign(sbh_parallel_t, InputIt first, Sentinel last) {
+        clear();
+#ifndef SINGLE_BUFFER_HASH_SET_NO_THREADS
+        if constexpr (std::random_access_iterator<InputIt>
+            && std::sized_sentinel_for<Sentinel, InputIt>
+            && std::is_same_v<std::remove_cvref_t<std::iter_reference_t<InputIt>>, value_type>) {
+            std::size_t n = static_cast<std::size_t>(last - first);
+            // 檩HindexOJmAdWLmax_sizeɧγv@JAѴJˬd
+            if (unsigned threads = _thread_count(n); threads > 1 && n <= max_size()) {
+                _parallel_assign(first, n, threads);
+                return;
+            }
         }
-        // غc~p䫢ƭ
-        forward_lists.emplace_back(std::forward<Args>(args)...);
-        index bucket_index = bucket(forward_lists.back().payload);
-        index exist_element = _index_find_impl(forward_lists.back().payload, bucket_index);
-        if (exist_element == npos) {
-            forward_lists.back().next = buckets[bucket_index];
-            return { (buckets[bucket_index] = forward_lists.size() - 1), true };
+#endif
+        insert_range(std::ranges::subrange(first, last));
+    }
+    // 妸J
+    // p@դƭȨùwAAwĤ@Ӹ`IA̫~̧ǴJAϧ֨Rۭ|
+    template <std::ranges::input_range R>
+    constexpr void insert_range(R&& range) {
+        if constexpr (std::ranges::forward_range<R>) {
+            if constexpr (AutoRehash && std::ranges::sized_range<R>) {
+                // wվơAϴJL{|orehash
+                _reserve_buckets(std::size_t(size()) + static_cast<std::size_t>(std::ranges::size(range)));
+            }
+            auto first = std::ranges::begin(range);
+            auto last = std::ranges::end(range);
+            std::size_t hash_codes[_batch_size];
+            index heads[_batch_size];
+            while (first != last) {
+                auto group_first = first;
+                size_type n = _prefetch_group(first, last, hash_codes, heads);
+                for (size_type i = 0; i < n; ++i, ++group_first) {
+                    _index_insert_hashed(*group_first, hash_codes[i]);
+                }
+            }
+        }
+        else {
+            for (auto&& value : range) {
+                _index_insert(std::forward<decltype(value)>(value));
+            }
+        }
+    }
+    // @ѼƥN@jM(AγzdiΪ)ATwsb~غcAPinsertۦP
+    // _hb|Wغc÷jMAubsbɤ~Jwİ
+    // p@ӭƪ|νwİϡA]|]wİϤwĲonstm
+    template <class... Args>
+    constexpr std::pair<index, bool> _index_emplace(Args&&... args) {
+        if constexpr (_emplace_as_key<Args...>) {
+            return _index_insert_impl(std::forward<Args>(args)...);
         }
         else {
-            forward_lists.pop_back();
-            return { exist_element, false };
+            value_type value(std::forward<Args>(args)...);
+            return _index_insert_impl(std::move(value));
         }
     }
     template <class... Args>
-    std::pair<const_iterator, bool> emplace(Args&&... args) {
+    constexpr std::pair<const_iterator, bool> emplace(Args&&... args) {
         auto temp = _index_emplace(std::forward<Args>(args)...);
         return { begin() + temp.first,temp.second };
     }
-
-    size_type erase(const key_type& value)
-        noexcept(noexcept(_erase_and_relink(0, 0, 0))
-            && noexcept(equal(std::declval<key_type>(), std::declval<key_type>()))) {
-        index bucket_index = bucket(value);
-        index list_index = buckets[bucket_index];
-        index before = npos;
-        while (list_index != npos) {
-            if (equal(value, forward_lists[list_index].payload)) {
-                _erase_and_relink(list_index, bucket_index, before);
-                return 1;
-            }
-            before = list_index;
-            list_index = forward_lists[list_index].next;
+    // Hwp⪺ƭȴNaغcAhash_codeHargsغcƭ
+    template <class... Args>
+    constexpr std::pair<index, bool> _index_emplace_hashed(hash_code_type hash_code, Args&&... args) {
+        if constexpr (_emplace_as_key<Args...>) {
+            assert(hash_code == hash(args...));
+            return _index_insert_hashed(std::forward<Args>(args)..., hash_code);
+        }
+        else {
+            value_type value(std::forward<Args>(args)...);
+            assert(hash_code == hash(value));
+            return _index_insert_hashed(std::move(value), hash_code);
         }
-        return 0;
-    }
-    void _index_erase(index Where)
-        noexcept(noexcept(_erase_and_relink(0, 0, 0))) {
-        assert(Where < size());
-        index bucket_index = bucket(forward_lists[Where].payload);
-        index before = _find_before(Where, bucket_index);
-        _erase_and_relink(Where, bucket_index, before);
     }
-    void erase(const_iterator Where)
-        noexcept(noexcept(_index_erase(0))) {
-        _index_erase(static_cast<index>(Where - begin()));
+    template <class... Args>
+    constexpr std::pair<const_iterator, bool> emplace_hashed(hash_code_type hash_code, Args&&... args) {
+        auto temp = _index_emplace_hashed(hash_code, std::forward<Args>(args)...);
+        return { begin() + temp.first,temp.second };
     }
 
-    [[nodiscard]] hasher hash_function() const noexcept(noexcept(hasher(hash))) {
-        return hash;
+    constexpr size_type erase(const key_type& value)
+        noexcept(noexcept(_erase_impl(std::declval<key_type>()))) {
+        return _erase_impl(value);
     }
-    [[nodiscard]] key_equal key_eq() const noexcept(noexcept(key_equal(equal))) {
-        return equal;
+    template <class K>
+        requires (_is_transparent
+            && !std::is_convertible_v<K&&, const_iterator>)
+    constexpr size_type erase(K&& value)
+        noexcept(noexcept(_erase_impl(std::declval<const K&>()))) {
+        return _erase_impl(value);
     }
-private:
-    void _check_rehash_required_1() {
-        if (static_cast<float>(size() + 1) / bucket_count() > max_load_factor()) {
-            rehash(static_cast<size_type>((size() + 8) / max_load_factor()));
-        }
+    // Hwp⪺ƭȲAhash_codehash_function()(key)
+    constexpr size_type erase(const key_type& value, hash_code_type hash_code)
+        noexcept(noexcept(_erase_prehashed(std::declval<key_type>(), 0, _ignore_relocation{}))) {
+        assert(hash_code == hash(value));
+        return _erase_prehashed(value, hash_code, _ignore_relocation{});
     }
-    index _index_find_impl(const value_type& value, index bucket_index)
-        const noexcept(noexcept(bucket(std::declval<key_type>())) && noexcept(equal(std::declval<key_type>(), std::declval<key_type>()))) {
-        index list_index = buckets[bucket_index];
-        while (list_index != npos) {
-            if (equal(value, forward_lists[list_index].payload)) {
-                return list_index;
-            }
-            list_index = forward_lists[list_index].next;
-        }
-        return npos;
+    template <class K>
+        requires (_is_transparent
+            && !std::is_convertible_v<const K&, const_iterator>)
+    constexpr size_type erase(const K& value, hash_code_type hash_code)
+        noexcept(noexcept(_erase_prehashed(std::declval<const K&>(), 0, _ignore_relocation{}))) {
+        assert(hash_code == hash(value));
+        return _erase_prehashed(value, hash_code, _ignore_relocation{});
     }
-    template <class LRvalue_type>
-    std::pair<index, bool> _index_insert_impl(LRvalue_type&& value) {
-        if constexpr (AutoRehash) {
-            _check_rehash_required_1();
-        }
-        index bucket_index = bucket(value);
-        index exist_element = _index_find_impl(value, bucket_index);
-        if (exist_element == npos) {
-            //NsJܱ}Y
-            forward_lists.emplace_back(std::forward<LRvalue_type>(value), buckets[bucket_index]);
-            return { (buckets[bucket_index] = static_cast<index>(forward_lists.size() - 1)), true };
+    constexpr void _index_erase(index Where)
+        noexcept(noexcept(_index_erase(0, _ignore_relocation{}))) {
+        _index_erase(Where, _ignore_relocation{});
+    }
+    // WhereA̫@ӤQJůʮɩIsrelocate(from, to)
+    template <class Relocate>
+    constexpr void _index_erase(index Where, Relocate relocate)
+        noexcept(noexcept(_erase_and_relink(0, std::declval<index&>(), 0))
+            && noexcept(_shrink_if_underloaded())
+            && noexcept(relocate(index(), index()))) {
+        assert(Where < size());
+        _count_operation(_erase_counter(), 0);
+        index last = static_cast<index>(size() - 1);
+        if (_is_small()) {
+            _small_erase(Where);
         }
         else {
-            return { exist_element ,false };
+            _step_migration();
+            index* head = _chain_of_hash(_hash_of(forward_lists[Where]));
+            index before = _find_before(Where, *head);
+            _erase_and_relink(Where, *head, before);
+            _shrink_if_underloaded();
         }
-    }
-    index _find_before(index Where, index bucket_index)
-        const noexcept {
-        index before = npos;
-        index now = buckets[bucket_index];
-        while (now != Where) {
-            before = now;
-            now = forward_lists[now].next;
+        if (Where != last) {
+            relocate(last, Where);
         }
-        return before;
     }
-    //ؼФåγ̫@Ӥɪů
-    void _erase_and_relink(index Where, index bucket_index, index before)
-        noexcept(noexcept(std::declval<value_type&>() = std::declval<value_type&&>())
-            && noexcept(bucket(std::declval<value_type>()))) {
-        //e@sU@
-        /*if (before == npos) {
-            buckets[bucket_index] = forward_lists[Where].next;
-        }
-        else {
+    constexpr void erase(const_iterator Where)
+        noexcept(noexcept(_index_erase(0))) {
+        erase_at(static_cast<index>(Where - begin()), _ignore_relocation{});
+    }
+    // Hindex@CsA~index}C(pơBɶWO)AgLt@ӹӪ
+    // insert_indexPfind_indexOP_index_insertB_index_findۦP
+    // erase_indexPkey۵A^ǲƶqF̫@ӤQJťXmɡA|bIsrelocate(from, to)
+    // uݭn@jMA~}CbrelocateNfromtoAAIh̫@CYiO
+    // erase_atHۦPWhindexAerase(const_iterator)NOݭnrelocateerase_at
+    // HindexPerase_index@ΦW١A_h䪺keyPindexLkϤ
+    constexpr std::pair<index, bool> insert_index(const value_type& value) {
+        return _index_insert(value);
+    }
+    constexpr std::pair<index, bool> insert_index(value_type&& value) {
+        return _index_insert(std::move(value));
+    }
+    template <class K>
+        requires (_is_transparent
+            && std::is_constructible_v<value_type, K&&>
+            && !std::is_same_v<std::remove_cvref_t<K>, value_type>)
+    constexpr std::pair<index, bool> insert_index(K&& value) {
+        return _index_insert_impl(std::forward<K>(value));
+    }
+    [[nodiscard]] constexpr index find_index(const key_type& keyval)
+        const noexcept(noexcept(_index_find_hetero(std::declval<key_type>()))) {
+        return _index_find_hetero(keyval);
+    }
+    template <class K>
+        requires _is_transparent
+    [[nodiscard]] constexpr index find_index(const K& keyval)
+        const noexcept(noexcept(_index_find_hetero(std::declval<const K&>()))) {
+        return _index_find_hetero(keyval);
+    }
+    template <std::invocable<index, index> Relocate>
+    constexpr size_type erase_index(const key_type& key, Relocate relocate)
+        noexcept(noexcept(_erase_impl(std::declval<key_type>(), std::declval<Relocate>()))) {
+        return _erase_impl(key, std::move(relocate));
+    }
+    template <class K, std::invocable<index, index> Relocate>
+        requires _is_transparent
+    constexpr size_type erase_index(const K& key, Relocate relocate)
+        noexcept(noexcept(_erase_impl(std::declval<const K&>(), std::declval<Relocate>()))) {
+        return _erase_impl(key, std::move(relocate));
+    }
+    template <std::invocable<index, index> Relocate>
+    constexpr void erase_at(index i, Relocate relocate)
+        noexcept(noexcept(_index_erase(0, std::declval<Relocate>()))) {
+        _index_erase(i, std::move(relocate));
+    }
+    // HU妸H@íwyYforward_listsAOdUӪ쥻۹ﶶǡA̫Aؤ@
+    // v@˥H̫@ӤɪůʨèXA]AX@jqA]|ôJ
+    // NOLײh֤AݭnXís걵ҦѤU
+    // [first, last)A^ǫV쥻lastN
+    const_iterator erase(const_iterator first, const_iterator last) {
+        index first_index = static_cast<index>(first - begin());
+        index last_index = static_cast<index>(last - begin());
+        if (first_index != last_index) {
+            _index_erase_if([=](index i) {
+                return i >= first_index && i < last_index;
+            });
+        }
+        return begin() + first_index;
+    }
+    // [first, last)CA^ǹڲƶq
+    // H妸jMаOҦnAA@Y
+    template <std::forward_iterator InputIt, std::sentinel_for<InputIt> Sentinel>
+    size_type erase_many(InputIt first, Sentinel last) {
+        return _index_erase_many(first, last, [](index, index) noexcept {});
+    }
+    template <class Predicate>
+    friend size_type erase_if(single_buffer_hash_set& set, Predicate pred) {
+        return set._index_erase_if([&](index i) {
+            return pred(std::as_const(set.forward_lists[i].payload));
+        });
+    }
+    // Ҧremove(i)trueiA^ǲƶq
+    // CӫOdUӥBmܪ|Isrelocate(from, to)Asingle_buffer_hash_mapǦPBʹ
+    // removeߥXҥ~ɡA|ˬdƫOdAeM
+    template <class Remove, class Relocate>
+    size_type _index_erase_if(Remove remove, Relocate relocate) {
+        std::size_t n = forward_lists.size();
+        std::size_t read = 0;
+        std::size_t write = 0;
+        auto keep = [&] {
+            if (write != read) {
+                forward_lists[write] = std::move(forward_lists[read]);
+                relocate(static_cast<index>(read), static_cast<index>(write));
+            }
+            ++write;
+        };
+        try {
+            for (; read < n; ++read) {
+                if (!remove(static_cast<index>(read))) {
+                    keep();
+                }
+            }
+        }
+        catch (...) {
+            for (; read < n; ++read) {
+                keep();
+            }
+            _finish_compaction(write);
+            throw;
+        }
+        _finish_compaction(write);
+        return static_cast<size_type>(n - write);
+    }
+    template <class Remove>
+    size_type _index_erase_if(Remove remove) {
+        return _index_erase_if(std::move(remove), [](index, index) noexcept {});
+    }
+    template <std::forward_iterator InputIt, std::sentinel_for<InputIt> Sentinel, class Relocate>
+    size_type _index_erase_many(InputIt first, Sentinel last, Relocate relocate) {
+        std::vector<bool> marked(size(), false);
+        std::size_t found = 0;
+        std::size_t hash_codes[_batch_size];
+        index heads[_batch_size];
+        while (first != last) {
+            InputIt group_first = first;
+            size_type n = _prefetch_group(first, last, hash_codes, heads);
+            for (size_type i = 0; i < n; ++i, ++group_first) {
+                index temp = _index_find_from(*group_first, hash_codes[i], heads[i], _erase_counter());
+                if (temp != npos && !marked[temp]) {
+                    marked[temp] = true;
+                    ++found;
+                }
+            }
+        }
+        if (found == 0) {
+            return 0;
+        }
+        return _index_erase_if([&](index i) noexcept {
+            return bool(marked[i]);
+        }, std::move(relocate));
+    }
+
+    // XB
+    // Xp@AåH妸jMbj@褤d䤸AҦn[J~@OdŶ
+    // wsb걵ܹAݭnAjMFƨƨSABStoreHashɡAϥΧ֨ƭ
+    // Nothersb󥻮eJeAotherudUӴNsbAPstd::unordered_set::mergeۦP
+    // JotherǪ[b̫AotherѤU쥻۹ﶶ
+    void merge(single_buffer_hash_set& other) {
+        if (&other == this || other.empty()) {
+            return;
+        }
+        std::vector<_pending> pending = _collect_missing(other);
+        if (pending.empty()) {
+            return;
+        }
+        _prepare_append(pending.size());
+        std::size_t appended = 0;
+        auto remove_moved = [&] {
+            std::vector<bool> moved(other.size(), false);
+            for (std::size_t i = 0; i < appended; ++i) {
+                moved[pending[i].source] = true;
+            }
+            other._index_erase_if([&](index i) noexcept {
+                return bool(moved[i]);
+            });
+        };
+        try {
+            _append_pending(other, pending, appended);
+        }
+        catch (...) {
+            remove_moved();
+            throw;
+        }
+        remove_moved();
+    }
+    void merge(single_buffer_hash_set&& other) {
+        merge(other);
+    }
+    // HUT̪ƨơBƻPtҨӦۤh@(ۦPɬa)
+    // PɦsbaPbA̸p@誺ǱƦC
+    friend single_buffer_hash_set set_intersection(const single_buffer_hash_set& a, const single_buffer_hash_set& b) {
+        const single_buffer_hash_set& larger = a.size() >= b.size() ? a : b;
+        const single_buffer_hash_set& smaller = a.size() >= b.size() ? b : a;
+        std::vector<_pending> pending = larger._collect(smaller, [](index found) {
+            return found != npos;
+        });
+        single_buffer_hash_set result = _empty_like(larger, false);
+        result._append_all(smaller, pending);
+        return result;
+    }
+    // aҦAAbǪ[sba
+    friend single_buffer_hash_set set_union(const single_buffer_hash_set& a, const single_buffer_hash_set& b) {
+        const single_buffer_hash_set& larger = a.size() >= b.size() ? a : b;
+        const single_buffer_hash_set& smaller = a.size() >= b.size() ? b : a;
+        std::vector<_pending> pending = larger._collect_missing(smaller);
+        if (larger.rehash_in_progress()) {
+            // ±]@ֽƻsAϥνƻsغc禡
+            single_buffer_hash_set result(larger,
+                std::allocator_traits<allocator_type>::select_on_container_copy_construction(larger.get_allocator()));
+            result._append_all(smaller, pending);
+            return result;
+        }
+        if (std::size_t(larger.size()) + pending.size() > larger.max_size()) {
+            _throw_length_error();
+        }
+        // Od̲שһݪeqAƻsAקK[ɭstm
+        single_buffer_hash_set result = _empty_like(larger, true);
+        result.forward_lists.reserve(larger.size() + pending.size());
+        result.forward_lists.insert(result.forward_lists.end(), larger.forward_lists.begin(), larger.forward_lists.end());
+        std::copy(larger.buckets.begin(), larger.buckets.end(), result.buckets.begin());
+        result._append_all(smaller, pending);
+        return result;
+    }
+    // sbasbbAaǱƦC
+    friend single_buffer_hash_set set_difference(const single_buffer_hash_set& a, const single_buffer_hash_set& b) {
+        if (a.size() <= b.size()) {
+            std::vector<_pending> pending = b._collect_missing(a);
+            single_buffer_hash_set result = _empty_like(b, false);
+            result._append_all(a, pending);
+            return result;
+        }
+        // ajɧאּHbbadAAƻsaSQ쪺íر
+        std::vector<bool> found(a.size(), false);
+        std::size_t count = 0;
+        a._probe(b, [&](index, index where, std::size_t) {
+            if (where != npos) {
+                found[where] = true;
+                ++count;
+            }
+        });
+        single_buffer_hash_set result = _empty_like(a, true);
+        result.forward_lists.reserve(a.size() - count);
+        for (index i = 0; i < a.size(); ++i) {
+            if (!found[i]) {
+                result.forward_lists.push_back(a.forward_lists[i]);
+            }
+        }
+        result._record_memory();
+        result._relink_any();
+        return result;
+    }
+
+    [[nodiscard]] constexpr hasher hash_function() const noexcept(noexcept(hasher(hash))) {
+        return hash;
+    }
+    [[nodiscard]] constexpr key_equal key_eq() const noexcept(noexcept(key_equal(equal))) {
+        return equal;
+    }
+private:
+#ifndef SINGLE_BUFFER_HASH_SET_NO_THREADS
+    // ƶqC󦹭ȮɡAإ߰󥭦ƪq
+    static constexpr std::size_t _parallel_threshold = std::size_t(1) << 17;
+    static constexpr unsigned _max_threads = 64;
+    // QPwƦӤOd
+    static constexpr index _duplicate = npos - 1;
+    // `ƨDȮɵLkإ߰
+    [[nodiscard]] static constexpr unsigned _thread_count(std::size_t n) noexcept {
+        if (n < _parallel_threshold || std::is_constant_evaluated()) {
+            return 1;
+        }
+        unsigned hardware = std::thread::hardware_concurrency();
+        return std::clamp(hardware, 1u, _max_threads);
+    }
+    // HtasksӰ(]tIs)f(0)...f(tasks - 1)
+    // u@ߥXҥ~|bҦu@᭫sߥXFLkإ߰ɡAѾlu@ѩIs̨̧ǰ
+    template <class F>
+    static void _parallel_for(unsigned tasks, F&& f) {
+        std::vector<std::exception_ptr> errors(tasks);
+        auto run = [&](unsigned task) noexcept {
+            try {
+                f(task);
+            }
+            catch (...) {
+                errors[task] = std::current_exception();
+            }
+        };
+        std::vector<std::thread> threads;
+        threads.reserve(tasks - 1);
+        unsigned task = 1;
+        try {
+            for (; task < tasks; ++task) {
+                threads.emplace_back(run, task);
+            }
+        }
+        catch (...) {
+            for (; task < tasks; ++task) {
+                run(task);
+            }
+        }
+        run(0);
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        for (auto& error : errors) {
+            if (error) {
+                std::rethrow_exception(error);
+            }
+        }
+    }
+    // N[0, n)partsqA^ǲpartq_I
+    [[nodiscard]] static std::size_t _split(std::size_t n, unsigned parts, unsigned part) noexcept {
+        return static_cast<std::size_t>((static_cast<std::uint64_t>(n) * part + parts - 1) / parts);
+    }
+    // ̱ީݪdAN[0, n)íwaparts
+    // pխtd[_split(nbuckets, parts, p), _split(nbuckets, parts, p + 1))A
+    // 䤸̻WǦsborder[group_begin[p], group_begin[p + 1])
+    static void _group_by_bucket(const index* bucket_of, std::size_t n, std::size_t nbuckets, unsigned parts,
+        std::vector<index>& order, std::vector<std::size_t>& group_begin) {
+        auto group_of = [=](index bucket_index) {
+            return static_cast<unsigned>(static_cast<std::uint64_t>(bucket_index) * parts / nbuckets);
+        };
+        // counts[chunk * parts + group]
+        std::vector<std::size_t> counts(std::size_t(parts) * parts, 0);
+        _parallel_for(parts, [&](unsigned chunk) {
+            std::size_t* count = counts.data() + std::size_t(chunk) * parts;
+            for (std::size_t i = _split(n, parts, chunk), last = _split(n, parts, chunk + 1); i < last; ++i) {
+                ++count[group_of(bucket_of[i])];
+            }
+        });
+        group_begin.assign(parts + 1, 0);
+        std::size_t running = 0;
+        for (unsigned group = 0; group < parts; ++group) {
+            group_begin[group] = running;
+            for (unsigned chunk = 0; chunk < parts; ++chunk) {
+                std::size_t temp = counts[std::size_t(chunk) * parts + group];
+                counts[std::size_t(chunk) * parts + group] = running;
+                running += temp;
+            }
+        }
+        group_begin[parts] = running;
+        order.resize(n);
+        _parallel_for(parts, [&](unsigned chunk) {
+            std::size_t* offset = counts.data() + std::size_t(chunk) * parts;
+            for (std::size_t i = _split(n, parts, chunk), last = _split(n, parts, chunk + 1); i < last; ++i) {
+                order[offset[group_of(bucket_of[i])]++] = static_cast<index>(i);
+            }
+        });
+    }
+    // rehash檩AGP`ǪۦP
+    void _parallel_relink(unsigned threads) {
+        std::size_t n = size();
+        std::vector<index> bucket_of(n);
+        _parallel_for(threads, [&](unsigned chunk) {
+            for (std::size_t i = _split(n, threads, chunk), last = _split(n, threads, chunk + 1); i < last; ++i) {
+                bucket_of[i] = _bucket_of_hash(_hash_of(forward_lists[i]));
+            }
+        });
+        std::vector<index> order;
+        std::vector<std::size_t> group_begin;
+        _group_by_bucket(bucket_of.data(), n, bucket_count(), threads, order, group_begin);
+        // Cեu|gJۤvd򤺪AHݩoǱ`IASv
+        _parallel_for(threads, [&](unsigned group) {
+            std::fill(buckets.begin() + _split(bucket_count(), threads, group),
+                buckets.begin() + _split(bucket_count(), threads, group + 1), npos);
+            for (std::size_t k = group_begin[group]; k < group_begin[group + 1]; ++k) {
+                index i = order[k];
+                forward_lists[i].next = buckets[bucket_of[i]];
+                buckets[bucket_of[i]] = i;
+            }
+        });
+    }
+    // ҦiߥXҥ~BJ(tmȦs}CPs}CBIshashPequalBƻs)bקe
+    // @BѮɡAeassign}Yclear()᪺ŪA
+    template <class RandomIt>
+    void _parallel_assign(RandomIt first, std::size_t n, unsigned threads) {
+        std::size_t nbuckets = bucket_count();
+        if constexpr (AutoRehash) {
+            nbuckets = (std::max)(nbuckets, BucketPolicy::round_up(_bucket_count_for(n + 8), max_bucket_count()));
+        }
+        assert(nbuckets > 0);
+        BucketPolicy policy = bucket_policy;
+        policy.assign(nbuckets);
+        _index_vector new_buckets(static_cast<size_type>(nbuckets), buckets.get_allocator());
+        std::vector<std::size_t> hash_codes(n);
+        std::vector<index> bucket_of(n);
+        _parallel_for(threads, [&](unsigned chunk) {
+            for (std::size_t i = _split(n, threads, chunk), last = _split(n, threads, chunk + 1); i < last; ++i) {
+                hash_codes[i] = hash(first[i]);
+                bucket_of[i] = static_cast<index>(policy(hash_codes[i], nbuckets));
+            }
+        });
+        std::vector<index> order;
+        std::vector<std::size_t> group_begin;
+        _group_by_bucket(bucket_of.data(), n, nbuckets, threads, order, group_begin);
+        // HJm@Ȯɪަ걵AƪаO_duplicate
+        std::vector<index> links(n);
+        _parallel_for(threads, [&](unsigned group) {
+            std::fill(new_buckets.begin() + _split(nbuckets, threads, group),
+                new_buckets.begin() + _split(nbuckets, threads, group + 1), npos);
+            for (std::size_t k = group_begin[group]; k < group_begin[group + 1]; ++k) {
+                index i = order[k];
+                index now = new_buckets[bucket_of[i]];
+                while (now != npos
+                    && !(hash_codes[now] == hash_codes[i] && equal(first[now], first[i]))) {
+                    now = links[now];
+                }
+                if (now == npos) {
+                    links[i] = new_buckets[bucket_of[i]];
+                    new_buckets[bucket_of[i]] = i;
+                }
+                else {
+                    links[i] = _duplicate;
+                }
+            }
+        });
+        // eMGnew_position[i]Jmibforward_lists
+        std::vector<index> new_position(n);
+        std::vector<std::size_t> kept(threads + 1, 0);
+        _parallel_for(threads, [&](unsigned chunk) {
+            std::size_t count = 0;
+            for (std::size_t i = _split(n, threads, chunk), last = _split(n, threads, chunk + 1); i < last; ++i) {
+                count += links[i] != _duplicate;
+            }
+            kept[chunk + 1] = count;
+        });
+        for (unsigned chunk = 0; chunk < threads; ++chunk) {
+            kept[chunk + 1] += kept[chunk];
+        }
+        _parallel_for(threads, [&](unsigned chunk) {
+            index position = static_cast<index>(kept[chunk]);
+            for (std::size_t i = _split(n, threads, chunk), last = _split(n, threads, chunk + 1); i < last; ++i) {
+                new_position[i] = position;
+                position += links[i] != _duplicate;
+            }
+        });
+        _parallel_for(threads, [&](unsigned group) {
+            for (std::size_t b = _split(nbuckets, threads, group), last = _split(nbuckets, threads, group + 1); b < last; ++b) {
+                if (new_buckets[b] != npos) {
+                    new_buckets[b] = new_position[new_buckets[b]];
+                }
+            }
+        });
+        // ƻşǶiALɤwݭn󫢧ƩΤ
+        try {
+            forward_lists.reserve(kept[threads]);
+            for (std::size_t i = 0; i < n; ++i) {
+                if (links[i] != _duplicate) {
+                    forward_lists.emplace_back(first[i],
+                        links[i] == npos ? npos : new_position[links[i]], hash_codes[i]);
+                }
+            }
+        }
+        catch (...) {
+            forward_lists.clear();
+            throw;
+        }
+        // HUҤ|ߥXҥ~
+        buckets.swap_storage(new_buckets);
+        bucket_policy = policy;
+        _record_memory();
+    }
+#endif
+    // XB⤤ݥ[JGsourceӷeindexAhash_codeeϥΪƭ
+    struct _pending {
+        index source;
+        std::size_t hash_code;
+    };
+    // POesource`IƭȡAƨƨSAɥiHϥsource֨
+    [[nodiscard]] std::size_t _hash_from([[maybe_unused]] const single_buffer_hash_set& source, const Node& node) const {
+        if constexpr (StoreHash && std::is_empty_v<Hash>) {
+            return node.hash_code;
+        }
+        else {
+            return hash(node.payload);
+        }
+    }
+    // sourceǥH妸jMbedsourceCӤA̧ǩIsvisit(i, found, hash_code)
+    // isourceindexAfounde۵index(sbɬnpos)
+    template <class Visit>
+    void _probe(const single_buffer_hash_set& source, Visit visit) const {
+        std::size_t hash_codes[_batch_size];
+        index heads[_batch_size];
+        auto first = source.forward_lists.begin();
+        auto last = source.forward_lists.end();
+        index i = 0;
+        while (first != last) {
+            auto group_first = first;
+            size_type n = _prefetch_group(first, last, hash_codes, heads, [&](const Node& node) {
+                return _hash_from(source, node);
+            });
+            for (size_type k = 0; k < n; ++k, ++group_first, ++i) {
+                visit(i, _index_find_from(group_first->payload, hash_codes[k], heads[k], _find_counter()), hash_codes[k]);
+            }
+        }
+    }
+    // sourcekeep(found)true
+    template <class Keep>
+    [[nodiscard]] std::vector<_pending> _collect(const single_buffer_hash_set& source, Keep keep) const {
+        std::vector<_pending> pending;
+        _probe(source, [&](index i, index found, std::size_t hash_code) {
+            if (keep(found)) {
+                pending.push_back({ i, hash_code });
+            }
+        });
+        return pending;
+    }
+    [[nodiscard]] std::vector<_pending> _collect_missing(const single_buffer_hash_set& source) const {
+        return _collect(source, [](index found) {
+            return found == npos;
+        });
+    }
+    // PmodelϥάۦPƨơBơBtPmax_load_factorŮe
+    // same_bucketsɨϥλPmodelۦPƻPFAutoRehashfalseɤ@ߦp
+    [[nodiscard]] static single_buffer_hash_set _empty_like(const single_buffer_hash_set& model, bool same_buckets) {
+        size_type nbuckets = 0;
+        if (same_buckets || !AutoRehash) {
+            nbuckets = model.bucket_count();
+        }
+        single_buffer_hash_set result(nbuckets, 0, model.hash, model.equal,
+            std::allocator_traits<allocator_type>::select_on_container_copy_construction(model.get_allocator()));
+        if constexpr (AutoRehash) {
+            result.max_load_factor(model.max_load_factor());
+        }
+        return result;
+    }
+    // wOd[JcountӷsһݪŶA_append_pendingL{|stmrehash
+    void _prepare_append(std::size_t count) {
+        if (std::size_t(size()) + count > max_size()) {
+            _throw_length_error();
+        }
+        reserve(static_cast<size_type>(size() + count));
+    }
+    // NsourcependingҦC[ܥeAoǤwsb󥻮eAݭnAjM
+    // sourceDconstɲʤA_hƻsFappendedOw[ƶqAѨҥ~Bzϥ
+    template <class Source>
+    void _append_pending(Source& source, const std::vector<_pending>& pending, std::size_t& appended) {
+        for (const _pending& p : pending) {
+            if constexpr (std::is_const_v<Source>) {
+                forward_lists.push_back(source.forward_lists[p.source]);
+            }
+            else {
+                forward_lists.push_back(std::move(source.forward_lists[p.source]));
+            }
+            forward_lists.back().set_hash(p.hash_code);
+            if (_is_small()) {
+                forward_lists.back().next = forward_lists.size() == 1 ?
+                    npos :
+                    static_cast<index>(forward_lists.size() - 2);
+            }
+            else {
+                index* head = _chain_of_hash(p.hash_code);
+                forward_lists.back().next = *head;
+                *head = static_cast<index>(forward_lists.size() - 1);
+            }
+            ++appended;
+        }
+    }
+    void _append_all(const single_buffer_hash_set& source, const std::vector<_pending>& pending) {
+        if (pending.empty()) {
+            return;
+        }
+        _prepare_append(pending.size());
+        std::size_t appended = 0;
+        _append_pending(source, pending, appended);
+    }
+    // forward_listsǭs걵ҦAƥj0
+    // uTnDBzrehash|ǤJparallelAJɦ۰XR@ߴ`Ǧ걵
+    constexpr void _relink([[maybe_unused]] bool parallel = false) {
+#ifndef SINGLE_BUFFER_HASH_SET_NO_THREADS
+        if (unsigned threads = parallel ? _thread_count(size()) : 1; threads > 1) {
+            try {
+                _parallel_relink(threads);
+                return;
+            }
+            catch (...) {
+                // Ȧs}CtmѩΫƨƩߥXҥ~ɧאּ걵APnext|sgJA_vT
+            }
+        }
+#endif
+        std::fill(buckets.begin(), buckets.end(), npos);
+        // ƨƦb~ߥXҥ~ɡA|걵LkQAH̪indexX]|VɡAuMŮe
+        try {
+            size_type i = 0;
+            for (auto& node : forward_lists) {
+                index temp = _bucket_of_hash(_hash_of(node));
+                node.next = buckets[temp];
+                buckets[temp] = i;
+                ++i;
+            }
+        }
+        catch (...) {
+            clear();
+            throw;
+        }
+    }
+    // HثeҦs걵ҦFAutoRehashfalseBƬ0ɮeiϥΡAݭn걵
+    constexpr void _relink_any() {
+        if (_is_small()) {
+            _link_small();
+        }
+        else if (bucket_count() != 0) {
+            _relink();
+        }
+    }
+    // 妸̫@BG[kept, size())wQíر
+    // irehashi椤ɪ걵ܷs
+    void _finish_compaction(std::size_t kept) {
+        if (kept == forward_lists.size()) {
+            return;
+        }
+        forward_lists.erase(forward_lists.begin() + static_cast<difference_type>(kept), forward_lists.end());
+        _discard_migration();
+        if (bucket_count() != 0) {
+            // ϥns걵ҦAKYp}C
+            if (size_type nbuckets = _underloaded_bucket_count(); nbuckets != 0) {
+                _try_resize_buckets(nbuckets);
+            }
+        }
+        _relink_any();
+    }
+    // 妸ާ@CճBzơAݨH\O驵ASܩw֨CbϥΫeQvX
+    static constexpr size_type _batch_size = 16;
+    // qfirst}lX̦h_batch_sizeAp⫢ƭȨùwPĤ@Ӹ`I
+    // ^ǹڨXơAfirst|eiU@ժ}Y
+    // hash_of(*first)ΨӨoƭȡAw]Ishash
+    template <class InputIt, class Sentinel>
+    constexpr size_type _prefetch_group(InputIt& first, Sentinel last, std::size_t* hash_codes, index* heads) const {
+        return _prefetch_group(first, last, hash_codes, heads, [this](const auto& key) {
+            return hash(key);
+        });
+    }
+    template <class InputIt, class Sentinel, class HashOf>
+    constexpr size_type _prefetch_group(InputIt& first, Sentinel last, std::size_t* hash_codes, index* heads, HashOf hash_of) const {
+        index* chains[_batch_size];
+        size_type n = 0;
+        if (_is_small()) {
+            // pҦUҦ䳣qP@}ljMAforward_listsܥiwgb֨
+            for (; n < _batch_size && first != last; ++n, ++first) {
+                hash_codes[n] = hash_of(*first);
+                heads[n] = _small_head();
+            }
+            return n;
+        }
+        for (; n < _batch_size && first != last; ++n, ++first) {
+            hash_codes[n] = hash_of(*first);
+            chains[n] = _chain_of_hash(hash_codes[n]);
+            sbh_prefetch(chains[n]);
+        }
+        for (size_type i = 0; i < n; ++i) {
+            heads[i] = *chains[i];
+            if (heads[i] != npos) {
+                sbh_prefetch(forward_lists.data() + heads[i]);
+            }
+        }
+        return n;
+    }
+    // pҦGAutoRehashBS}CAƶqWLsmall_size
+    // @䪺jMBJP̯ޱys򪺸`IAݨCӸ`InextJ
+    // Ҧ̯޻ꦨ@AYinexti - 1A}Y̫@Ӥ
+    // p@ӧ妸ާ@uݭn}Y̫@ӤA_index_find_fromX禡ݭnק
+    [[nodiscard]] constexpr bool _is_small() const noexcept {
+        if constexpr (AutoRehash) {
+            return buckets.size() == 0;
+        }
+        else {
+            return false;
+        }
+    }
+    [[nodiscard]] constexpr index _small_head() const noexcept {
+        return forward_lists.empty() ?
+            npos :
+            static_cast<index>(forward_lists.size() - 1);
+    }
+    // pҦUXɡAStoreHashPFingerprintҬfalseɧ|Ψ쫢ƭ
+    static constexpr bool _small_needs_hash = StoreHash || _store_fingerprint;
+    // jMvalueһݪƭȡApҦUΤɤp
+    template <class K>
+    [[nodiscard]] constexpr std::size_t _lookup_hash(const K& value) const
+        noexcept(noexcept(hash(std::declval<const K&>()))) {
+        if constexpr (!_small_needs_hash) {
+            if (_is_small()) {
+                return 0;
+            }
+        }
+        return hash(value);
+    }
+    // ̤pҦWhs걵Ҧ
+    constexpr void _link_small() noexcept {
+        index i = 0;
+        for (auto& node : forward_lists) {
+            node.next = i == 0 ?
+                npos :
+                static_cast<index>(i - 1);
+            ++i;
+        }
+    }
+    // TOenӤɤݭnrehashApҦUnWLsmall_sizeɤtm}C
+    constexpr void _reserve_buckets(std::size_t n) {
+        if (_is_small() && n <= small_size) {
+            return;
+        }
+        rehash(_bucket_count_for(n + 8));
+    }
+    // Hƭȭp
+    [[nodiscard]] constexpr index _bucket_of_hash(std::size_t hash_code) const noexcept {
+        assert(buckets.size() > 0);
+        return static_cast<index>(bucket_policy(hash_code, buckets.size()));
+    }
+    // ƭȬhash_codeҦb}Y
+    // irehashi椤B±|Eɬ±A_hs
+    [[nodiscard]] constexpr index* _chain_of_hash(std::size_t hash_code) const noexcept {
+        if constexpr (IncrementalRehash) {
+            if (rehash_in_progress()) {
+                auto old_index = static_cast<index>(migration.old_policy(hash_code, migration.old_buckets.size()));
+                if (old_index >= migration.cursor) {
+                    return migration.old_buckets.begin() + old_index;
+                }
+            }
+        }
+        return buckets.begin() + _bucket_of_hash(hash_code);
+    }
+    // CJβɾE±ƶq
+    // t]l1ɡA±|bAݭnXReE
+    static constexpr size_type _migration_step = 8;
+    // }lirehashGtmsߧY^Adb±WACJβɦAE_migration_step±
+    constexpr void _begin_incremental_rehash(size_type nbuckets) {
+        finish_rehash();
+        nbuckets = static_cast<size_type>(BucketPolicy::round_up(nbuckets, max_bucket_count()));
+        if (nbuckets <= bucket_count()) {
+            return;
+        }
+        [[maybe_unused]] auto timer = _time_rehash();
+        if constexpr (Statistics) {
+            ++statistics.rehashes;
+        }
+        _index_vector new_buckets(nbuckets, npos, buckets.get_allocator());
+        new_buckets.max_load_factor = buckets.max_load_factor;
+        migration.old_buckets = std::move(buckets);
+        migration.old_policy = bucket_policy;
+        migration.cursor = 0;
+        buckets = std::move(new_buckets);
+        bucket_policy.assign(nbuckets);
+        _record_memory();
+    }
+    constexpr void _step_migration()
+        noexcept(noexcept(_hash_of(std::declval<const Node&>()))) {
+        if constexpr (IncrementalRehash) {
+            if (rehash_in_progress()) {
+                _migrate_buckets(_migration_step);
+            }
+        }
+    }
+    // N̦hcount±Ws
+    // Cʤ@Ӹ`INs±}YAYϫƨƩߥXҥ~ACӤ]MY
+    constexpr void _migrate_buckets(size_type count)
+        noexcept(noexcept(_hash_of(std::declval<const Node&>()))) {
+        if constexpr (IncrementalRehash) {
+            [[maybe_unused]] auto timer = _time_rehash();
+            auto& old_buckets = migration.old_buckets;
+            index last = static_cast<index>((std::min<std::size_t>)(std::size_t(migration.cursor) + count, old_buckets.size()));
+            for (; migration.cursor < last; ++migration.cursor) {
+                index& old_head = old_buckets[migration.cursor];
+                while (old_head != npos) {
+                    index now = old_head;
+                    index& new_head = buckets[_bucket_of_hash(_hash_of(forward_lists[now]))];
+                    old_head = forward_lists[now].next;
+                    forward_lists[now].next = new_head;
+                    new_head = now;
+                }
+            }
+            if (migration.cursor == old_buckets.size()) {
+                _discard_migration();
+            }
+        }
+    }
+    // ±PbucketsϥάۦPtAʮɤ~ઽްO
+    [[nodiscard]] static constexpr auto _make_migration([[maybe_unused]] const allocator_type& alloc) {
+        if constexpr (IncrementalRehash) {
+            return _migration{ _index_vector(0, _index_allocator(alloc)), BucketPolicy(), 0 };
+        }
+        else {
+            return std::monostate();
+        }
+    }
+    template <class Migration>
+    [[nodiscard]] static constexpr auto _migration_with([[maybe_unused]] Migration&& other, [[maybe_unused]] const allocator_type& alloc) {
+        if constexpr (IncrementalRehash) {
+            return _migration{ _index_vector(std::forward<Migration>(other).old_buckets, _index_allocator(alloc)),
+                other.old_policy, other.cursor };
+        }
+        else {
+            return std::monostate();
+        }
+    }
+    constexpr void _discard_migration() noexcept {
+        if constexpr (IncrementalRehash) {
+            migration.old_buckets.clear();
+            migration.cursor = 0;
+        }
+    }
+    // o`IƭȡAStoreHashɪϥΧ֨
+    [[nodiscard]] constexpr std::size_t _hash_of(const Node& node) const
+        noexcept(StoreHash || noexcept(hash(std::declval<key_type>()))) {
+        if constexpr (StoreHash) {
+            return node.hash_code;
+        }
+        else {
+            return hash(node.payload);
+        }
+    }
+    // `IƭȩΫPhash_codeO_i۲šA̬ҥxsɫtrueAkey_equalP_
+    [[nodiscard]] static constexpr bool _hash_equal([[maybe_unused]] const Node& node, [[maybe_unused]] std::size_t hash_code) noexcept {
+        if constexpr (StoreHash) {
+            return node.hash_code == hash_code;
+        }
+        else if constexpr (_store_fingerprint) {
+            return node.fingerprint == _fingerprint_of(hash_code);
+        }
+        else {
+            return true;
+        }
+    }
+    // ƭȭW@ө_Ʊ`ƫ᪺̰8줸@
+    // ϥλP޵P`ơAקKP@ӱ`OoۦP
+    [[nodiscard]] static constexpr std::uint8_t _fingerprint_of(std::size_t hash_code) noexcept {
+        if constexpr (sizeof(std::size_t) > sizeof(std::uint32_t)) {
+            return static_cast<std::uint8_t>((hash_code * 0xC2B2AE3D27D4EB4F) >> 56);
+        }
+        else {
+            return static_cast<std::uint8_t>((hash_code * 0x85EBCA77u) >> 24);
+        }
+    }
+    // forward_listseqP}CΪ줸ռ
+    [[nodiscard]] constexpr std::size_t _memory_usage() const noexcept {
+        std::size_t bytes = forward_lists.capacity() * sizeof(Node) + std::size_t(buckets.size()) * sizeof(index);
+        if constexpr (IncrementalRehash) {
+            bytes += std::size_t(migration.old_buckets.size()) * sizeof(index);
+        }
+        return bytes;
+    }
+    // HUҥubStatisticsɦ@ΡA_hơA]ΥŶ
+    constexpr void _record_memory() const noexcept {
+        if constexpr (Statistics) {
+            statistics.peak_bytes = (std::max)(statistics.peak_bytes, _memory_usage());
+        }
+    }
+    // Uؾާ@pƾAҥήɦ^ǦPˬŪstatistics
+    [[nodiscard]] constexpr _probe_counter& _find_counter() const noexcept {
+        if constexpr (Statistics) {
+            return statistics.find;
+        }
+        else {
+            return statistics;
+        }
+    }
+    [[nodiscard]] constexpr _probe_counter& _insert_counter() const noexcept {
+        if constexpr (Statistics) {
+            return statistics.insert;
+        }
+        else {
+            return statistics;
+        }
+    }
+    [[nodiscard]] constexpr _probe_counter& _erase_counter() const noexcept {
+        if constexpr (Statistics) {
+            return statistics.erase;
+        }
+        else {
+            return statistics;
+        }
+    }
+    // ֭p@qX`I
+    static constexpr void _count_walk([[maybe_unused]] _probe_counter& counter, [[maybe_unused]] std::size_t probes) noexcept {
+        if constexpr (Statistics) {
+            counter.probes += probes;
+            counter.max_probes = (std::max)(counter.max_probes, probes);
+        }
+    }
+    // ֭p@ާ@P䨫X`I
+    static constexpr void _count_operation([[maybe_unused]] _probe_counter& counter, [[maybe_unused]] std::size_t probes) noexcept {
+        if constexpr (Statistics) {
+            ++counter.operations;
+            _count_walk(counter, probes);
+        }
+    }
+    template <class K>
+    [[nodiscard]] constexpr bool _key_equal(const K& value, const key_type& key, [[maybe_unused]] _probe_counter& counter)
+        const noexcept(noexcept(equal(std::declval<const K&>(), std::declval<const key_type&>()))) {
+        if constexpr (Statistics) {
+            ++counter.comparisons;
+        }
+        return equal(value, key);
+    }
+    // bѺcɱNgLɶ֭prehash_nanosecondsA`ƨDȮɵLkŪAp
+    struct _rehash_timer {
+        _counters& counters;
+        std::chrono::steady_clock::time_point start;
+        constexpr explicit _rehash_timer(_counters& Counters) noexcept :counters(Counters) {
+            if (!std::is_constant_evaluated()) {
+                start = std::chrono::steady_clock::now();
+            }
+        }
+        constexpr ~_rehash_timer() noexcept {
+            if (!std::is_constant_evaluated()) {
+                counters.rehash_nanoseconds += static_cast<std::size_t>(
+                    std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+            }
+        }
+    };
+    [[nodiscard]] constexpr auto _time_rehash() const noexcept {
+        if constexpr (Statistics) {
+            return _rehash_timer{ statistics };
+        }
+        else {
+            return std::monostate();
+        }
+    }
+    // ܱƨçs޵A쥻e|QAIs̥s걵Ҧ
+    constexpr void _resize_buckets(size_type nbuckets) {
+        if constexpr (Statistics) {
+            ++statistics.rehashes;
+        }
+        buckets.resize(nbuckets);
+        bucket_policy.assign(nbuckets);
+        _record_memory();
+    }
+    // Yp}CuOFOAtmѮɫOd쥻Yi
+    constexpr bool _try_resize_buckets(size_type nbuckets) noexcept {
+        try {
+            _resize_buckets(nbuckets);
+            return true;
+        }
+        catch (...) {
+            return false;
+        }
+    }
+    // enӤӤWLmax_load_factor̤pıơAܤ֬1
+    [[nodiscard]] constexpr size_type _smallest_bucket_count(std::size_t n) const noexcept {
+        return static_cast<size_type>(BucketPolicy::round_up((std::max)(_bucket_count_for(n), size_type(1)), max_bucket_count()));
+    }
+    // t]lCmin_load_factorYpܪơAݭnYpɬ0AԨmin_load_factor
+    [[nodiscard]] constexpr size_type _underloaded_bucket_count() const noexcept {
+        if constexpr (ShrinkOnErase) {
+            float threshold = (std::min)(minimum_load_factor, max_load_factor() / 4);
+            if (threshold > 0 && float(size()) < threshold * float(bucket_count())) [[unlikely]] {
+                size_type nbuckets = _smallest_bucket_count(std::size_t(size()) * 2);
+                if (nbuckets < bucket_count()) {
+                    return nbuckets;
+                }
+            }
+        }
+        return 0;
+    }
+    // v@ˬdO_ݭnYp}C
+    constexpr void _shrink_if_underloaded()
+        noexcept(noexcept(_hash_of(std::declval<const Node&>()))) {
+        if (size_type nbuckets = _underloaded_bucket_count(); nbuckets != 0) {
+            [[maybe_unused]] auto timer = _time_rehash();
+            if (_try_resize_buckets(nbuckets)) {
+                _discard_migration();
+                _relink();
+            }
+        }
+    }
+    // enӤӤWLmax_load_factorһݪơAHBIƭpHKindexɷAíbmax_bucket_countH
+    [[nodiscard]] constexpr size_type _bucket_count_for(std::size_t n) const noexcept {
+        double required = double(n) / max_load_factor();
+        return required >= double(max_bucket_count()) ?
+            max_bucket_count() :
+            static_cast<size_type>(required);
+    }
+    // ƶqwFmax_sizeAindexLkAܷsm
+    [[noreturn]] static void _throw_length_error() {
+        throw std::length_error("single_buffer_hash_set too long");
+    }
+    constexpr void _check_rehash_required_1() {
+        _step_migration();
+        if (static_cast<float>(size() + 1) / bucket_count() > max_load_factor()) {
+            std::size_t required = BucketPolicy::grow(bucket_count(), _bucket_count_for(std::size_t(size()) + 8));
+            if constexpr (IncrementalRehash) {
+                _begin_incremental_rehash(static_cast<size_type>((std::min<std::size_t>)(required, max_bucket_count())));
+            }
+            else {
+                rehash(static_cast<size_type>((std::min<std::size_t>)(required, max_bucket_count())));
+            }
+        }
+    }
+    template <class K>
+    constexpr index _index_find_prehashed(const K& keyval, std::size_t hash_code)
+        const noexcept(noexcept(_index_find_from(std::declval<const K&>(), 0, 0, std::declval<_probe_counter&>()))) {
+        assert(hash_code == hash(keyval));
+        if (_is_small()) {
+            return _small_find(keyval, hash_code, _find_counter());
+        }
+        return _index_find_from(keyval, hash_code, *_chain_of_hash(hash_code), _find_counter());
+    }
+    template <class K>
+    constexpr index _index_find_hetero(const K& keyval)
+        const noexcept(noexcept(hash(std::declval<const K&>()))
+            && noexcept(_index_find_from(std::declval<const K&>(), 0, 0, std::declval<_probe_counter&>()))) {
+        std::size_t hash_code = _lookup_hash(keyval);
+        if (_is_small()) {
+            return _small_find(keyval, hash_code, _find_counter());
+        }
+        return _index_find_from(keyval, hash_code, *_chain_of_hash(hash_code), _find_counter());
+    }
+    // pҦUjM
+    // RmCPɡAN}jXGC|wѡA]HS䪺jX̫@ӫƭ(Ϋ)ۦPAA@
+    // S֨ƭȮɡAiZƻs䪽HP˪覡FƭȬۦP䤣PALkKyaɡA~v@
+    template <class K>
+    constexpr index _small_find(const K& value, [[maybe_unused]] std::size_t hash_code, [[maybe_unused]] _probe_counter& counter)
+        const noexcept(noexcept(equal(std::declval<const K&>(), std::declval<const key_type&>()))) {
+        const Node* first = forward_lists.data();
+        const Node* last = first + forward_lists.size();
+        _count_operation(counter, forward_lists.size());
+        if constexpr (StoreHash || _store_fingerprint || std::is_trivially_copyable_v<key_type>) {
+            const Node* found = nullptr;
+            for (const Node* node = first; node != last; ++node) {
+                bool match;
+                if constexpr (StoreHash || _store_fingerprint) {
+                    match = _hash_equal(*node, hash_code);
+                }
+                else {
+                    match = _key_equal(value, node->payload, counter);
+                }
+                found = match ?
+                    node :
+                    found;
+            }
+            if (found == nullptr) {
+                return npos;
+            }
+            if constexpr (StoreHash || _store_fingerprint) {
+                if (!_key_equal(value, found->payload, counter)) [[unlikely]] {
+                    return _small_find_each(value, hash_code, counter);
+                }
+            }
+            return static_cast<index>(found - first);
+        }
+        else {
+            return _small_find_each(value, hash_code, counter);
+        }
+    }
+    template <class K>
+    constexpr index _small_find_each(const K& value, [[maybe_unused]] std::size_t hash_code, [[maybe_unused]] _probe_counter& counter)
+        const noexcept(noexcept(equal(std::declval<const K&>(), std::declval<const key_type&>()))) {
+        for (std::size_t i = forward_lists.size(); i-- > 0;) {
+            if (_hash_equal(forward_lists[i], hash_code) && _key_equal(value, forward_lists[i].payload, counter)) {
+                return static_cast<index>(i);
+            }
+        }
+        return npos;
+    }
+    // qlist_index}ljMAStatisticsɱNX`IƻPƲ֭pcounter
+    template <class K>
+    constexpr index _index_find_from(const K& value, [[maybe_unused]] std::size_t hash_code, index list_index, [[maybe_unused]] _probe_counter& counter)
+        const noexcept(noexcept(equal(std::declval<const K&>(), std::declval<const key_type&>()))) {
+        [[maybe_unused]] std::size_t probes = 0;
+        while (list_index != npos) {
+            if constexpr (Statistics) {
+                ++probes;
+            }
+            if (_hash_equal(forward_lists[list_index], hash_code)
+                && _key_equal(value, forward_lists[list_index].payload, counter)) {
+                _count_operation(counter, probes);
+                return list_index;
+            }
+            list_index = forward_lists[list_index].next;
+        }
+        _count_operation(counter, probes);
+        return npos;
+    }
+    template <class LRvalue_type>
+    constexpr std::pair<index, bool> _index_insert_impl(LRvalue_type&& value) {
+        if constexpr (AutoRehash && !_small_needs_hash) {
+            // JᤴpҦɤݭnƭ
+            if (_is_small() && size() < small_size) {
+                return _index_insert_hashed(std::forward<LRvalue_type>(value), 0);
+            }
+        }
+        return _index_insert_hashed(std::forward<LRvalue_type>(value), hash(value));
+    }
+    template <class LRvalue_type>
+    constexpr std::pair<index, bool> _index_insert_hashed(LRvalue_type&& value, std::size_t hash_code) {
+        if constexpr (AutoRehash) {
+            if (_is_small()) {
+                index exist_element = _small_find(value, hash_code, _insert_counter());
+                if (exist_element != npos) {
+                    return { exist_element, false };
+                }
+                if (size() < small_size) {
+                    return _small_append(std::forward<LRvalue_type>(value), hash_code);
+                }
+                // pҦwA@إߧ㪺}CAϥκirehash
+                rehash(_bucket_count_for(std::size_t(size()) + 8));
+            }
+            else {
+                _check_rehash_required_1();
+            }
+        }
+        index* head = _chain_of_hash(hash_code);
+        index exist_element = _index_find_from(value, hash_code, *head, _insert_counter());
+        if (exist_element == npos) {
+            if (size() == max_size()) [[unlikely]] {
+                _throw_length_error();
+            }
+            //NsJܱ}Y
+            if constexpr (std::is_same_v<std::remove_cvref_t<LRvalue_type>, value_type>) {
+                forward_lists.emplace_back(std::forward<LRvalue_type>(value), *head, hash_code);
+            }
+            else {
+                //贡JGTwsb~غc
+                forward_lists.emplace_back(value_type(std::forward<LRvalue_type>(value)), *head, hash_code);
+            }
+            _record_memory();
+            return { (*head = static_cast<index>(forward_lists.size() - 1)), true };
+        }
+        else {
+            return { exist_element ,false };
+        }
+    }
+    // pҦU[TwsbAs}Y
+    template <class LRvalue_type>
+    constexpr std::pair<index, bool> _small_append(LRvalue_type&& value, std::size_t hash_code) {
+        index head = _small_head();
+        if constexpr (std::is_same_v<std::remove_cvref_t<LRvalue_type>, value_type>) {
+            forward_lists.emplace_back(std::forward<LRvalue_type>(value), head, hash_code);
+        }
+        else {
+            forward_lists.emplace_back(value_type(std::forward<LRvalue_type>(value)), head, hash_code);
+        }
+        _record_memory();
+        return { static_cast<index>(forward_lists.size() - 1), true };
+    }
+    // pҦUAH̫@ӤɪůʫᱵW쥻WhereeYi
+    constexpr void _small_erase(index Where)
+        noexcept(noexcept(std::declval<value_type&>() = std::declval<value_type&&>())) {
+        if (Where != size() - 1) {
+            forward_lists[Where] = std::move(forward_lists.back());
+            forward_lists[Where].next = Where == 0 ?
+                npos :
+                static_cast<index>(Where - 1);
+        }
+        forward_lists.pop_back();
+    }
+    // ɤݭnoʪIs̨ϥ
+    struct _ignore_relocation {
+        constexpr void operator()(index, index) const noexcept {}
+    };
+    // Pvalue۵A̫@ӤQJůʮɩIsrelocate(from, to)
+    template <class K, class Relocate = _ignore_relocation>
+    constexpr size_type _erase_impl(const K& value, Relocate relocate = {})
+        noexcept(noexcept(hash(std::declval<const K&>()))
+            && noexcept(_erase_prehashed(std::declval<const K&>(), 0, std::declval<Relocate>()))) {
+        return _erase_prehashed(value, _lookup_hash(value), std::move(relocate));
+    }
+    // P_erase_implۦPAϥΩIs̵wƭȡFpҦݭnƭȮhash_codeiHON
+    template <class K, class Relocate>
+    constexpr size_type _erase_prehashed(const K& value, std::size_t hash_code, Relocate relocate)
+        noexcept(noexcept(_erase_and_relink(0, std::declval<index&>(), 0))
+            && noexcept(equal(std::declval<const K&>(), std::declval<const key_type&>()))
+            && noexcept(_shrink_if_underloaded())
+            && noexcept(relocate(index(), index()))) {
+        if (_is_small()) {
+            index found = _small_find(value, hash_code, _erase_counter());
+            if (found == npos) {
+                return 0;
+            }
+            index last = static_cast<index>(size() - 1);
+            _small_erase(found);
+            if (found != last) {
+                relocate(last, found);
+            }
+            return 1;
+        }
+        _step_migration();
+        index* head = _chain_of_hash(hash_code);
+        index list_index = *head;
+        index before = npos;
+        [[maybe_unused]] std::size_t probes = 0;
+        while (list_index != npos) {
+            if constexpr (Statistics) {
+                ++probes;
+            }
+            if (_hash_equal(forward_lists[list_index], hash_code)
+                && _key_equal(value, forward_lists[list_index].payload, _erase_counter())) {
+                _count_operation(_erase_counter(), probes);
+                index last = static_cast<index>(size() - 1);
+                _erase_and_relink(list_index, *head, before);
+                _shrink_if_underloaded();
+                if (list_index != last) {
+                    relocate(last, list_index);
+                }
+                return 1;
+            }
+            before = list_index;
+            list_index = forward_lists[list_index].next;
+        }
+        _count_operation(_erase_counter(), probes);
+        return 0;
+    }
+    constexpr index _find_before(index Where, index head)
+        const noexcept {
+        index before = npos;
+        index now = head;
+        [[maybe_unused]] std::size_t probes = 0;
+        while (now != Where) {
+            if constexpr (Statistics) {
+                ++probes;
+            }
+            before = now;
+            now = forward_lists[now].next;
+        }
+        _count_walk(_erase_counter(), probes);
+        return before;
+    }
+    //ؼФåγ̫@Ӥɪů
+    constexpr void _erase_and_relink(index Where, index& head, index before)
+        noexcept(noexcept(std::declval<value_type&>() = std::declval<value_type&&>())
+            && noexcept(_hash_of(std::declval<const Node&>()))) {
+        //e@sU@
+        /*if (before == npos) {
+            head = forward_lists[Where].next;
+        }
+        else {
             forward_lists[before].next = forward_lists[Where].next;
         }*/
         (before == npos ?
-            buckets[bucket_index] :
+            head :
             forward_lists[before].next)
             = forward_lists[Where].next;
         //̫@
         if (Where != size() - 1) {
-            index bucket_of_back = bucket(forward_lists.back().payload);
-            index before_back = _find_before(size() - 1, bucket_of_back);
+            index& head_of_back = *_chain_of_hash(_hash_of(forward_lists.back()));
+            index before_back = _find_before(size() - 1, head_of_back);
             //ʳ̫@ӤůʳB
             /*if (before_back == npos) {
-                buckets[bucket_of_back] = Where;
+                head_of_back = Where;
             }
             else {
                 forward_lists[before_back].next = Where;
             }*/
             (before_back == npos ?
-                buckets[bucket_of_back] :
+                head_of_back :
                 forward_lists[before_back].next)
                 = Where;
             forward_lists[Where] = std::move(forward_lists.back());
@@ -553,6 +2505,21 @@ private:
         forward_lists.pop_back();
     }
 };
+// Pstd::pmr::unordered_setۦPAHstd::pmr::polymorphic_allocatortmҦO
+template <
+    class Key,
+    class Hash = std::hash<Key>,
+    class Pred = std::equal_to<Key>,
+    bool AutoRehash = true,
+    bool StoreHash = sbh_default_store_hash<Hash>,
+    class BucketPolicy = sbh_prime_modulo,
+    bool Fingerprint = false,
+    bool IncrementalRehash = false,
+    bool Statistics = false,
+    class Index = std::uint32_t,
+    bool ShrinkOnErase = false>
+using pmr_single_buffer_hash_set = single_buffer_hash_set<Key, Hash, Pred, std::pmr::polymorphic_allocator<Key>,
+    AutoRehash, StoreHash, BucketPolicy, Fingerprint, IncrementalRehash, Statistics, Index, ShrinkOnErase>;
 #else
 #error C++20 or later required
 #endif // _HAS_CXX20
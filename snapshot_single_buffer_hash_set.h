@@ -0,0 +1,521 @@
+#pragma once
+#ifndef SNAPSHOT_SINGLE_BUFFER_HASH_SET
+#define SNAPSHOT_SINGLE_BUFFER_HASH_SET
+#include "single_buffer_hash_set.h"
+#include <array>
+#include <atomic>
+#include <memory>
+#if _HAS_CXX20 || __cplusplus >= 202002L
+// [ư}CGHTweתhh`I(radix tree)xsA`IOschunk_sizeӤ
+// share()uƻsڸ`IСA]OO(1)A@ΩҦ`I
+// קɥuƻsqڨӤ|W٤ݩۤv`I(|ƻs)AC|b⦸share()̦hƻs@
+// CӸ`IOإߥeditAPۤvثeeditۦP`IuݩۤvAiHק
+// `I@Q@δNAQקA]@θ`ILiHbLPŪ
+template <class T, unsigned Bits = 6>
+class sbh_persistent_vector {
+public:
+    static constexpr std::size_t chunk_size = std::size_t(1) << Bits;
+private:
+    static constexpr std::size_t _mask = chunk_size - 1;
+    struct _node {
+        std::uint64_t edit;
+    };
+    struct _leaf : _node {
+        std::vector<T> items;
+    };
+    struct _inner : _node {
+        std::array<std::shared_ptr<_node>, chunk_size> children;
+    };
+    std::shared_ptr<_node> root;
+    std::size_t _size = 0;
+    unsigned shift = 0; // ڸ`I첾A0ܮڸ`INO`I
+    std::uint64_t edit = _new_edit();
+    sbh_persistent_vector(const sbh_persistent_vector&) = default;
+public:
+    sbh_persistent_vector() noexcept = default;
+    sbh_persistent_vector(sbh_persistent_vector&&) noexcept = default;
+    sbh_persistent_vector& operator=(sbh_persistent_vector&&) noexcept = default;
+    // ^ǻPۤv@ΩҦ`IƥAۤvק藍|vTƥAϤM
+    [[nodiscard]] sbh_persistent_vector share() {
+        sbh_persistent_vector copy(*this);
+        copy.edit = _new_edit();
+        edit = _new_edit();
+        return copy;
+    }
+    [[nodiscard]] std::size_t size() const noexcept {
+        return _size;
+    }
+    [[nodiscard]] bool empty() const noexcept {
+        return _size == 0;
+    }
+    [[nodiscard]] const T& operator[](std::size_t i) const noexcept {
+        assert(i < _size);
+        const _node* now = root.get();
+        for (unsigned s = shift; s > 0; s -= Bits) {
+            now = static_cast<const _inner*>(now)->children[(i >> s) & _mask].get();
+        }
+        return static_cast<const _leaf*>(now)->items[i & _mask];
+    }
+    // oiק諸ѦҡAnɽƻs|W`I
+    [[nodiscard]] T& mutable_at(std::size_t i) {
+        assert(i < _size);
+        std::shared_ptr<_node>* slot = &root;
+        for (unsigned s = shift; s > 0; s -= Bits) {
+            slot = &static_cast<_inner*>(_own(*slot, false))->children[(i >> s) & _mask];
+        }
+        return static_cast<_leaf*>(_own(*slot, true))->items[i & _mask];
+    }
+    void push_back(T value) {
+        if (!root) {
+            root = _new_leaf();
+            shift = 0;
+        }
+        else if (_size == (chunk_size << shift)) {
+            // wA[W@hsڸ`I
+            auto inner = _new_inner();
+            inner->children[0] = std::move(root);
+            root = std::move(inner);
+            shift += Bits;
+        }
+        std::shared_ptr<_node>* slot = &root;
+        for (unsigned s = shift; s > 0; s -= Bits) {
+            slot = &static_cast<_inner*>(_own(*slot, false))->children[(_size >> s) & _mask];
+            if (!*slot) {
+                if (s == Bits) {
+                    *slot = _new_leaf();
+                }
+                else {
+                    *slot = _new_inner();
+                }
+            }
+        }
+        static_cast<_leaf*>(_own(*slot, true))->items.push_back(std::move(value));
+        ++_size;
+    }
+    void pop_back() {
+        assert(_size != 0);
+        std::size_t i = --_size;
+        if (_size == 0) {
+            clear();
+            return;
+        }
+        std::shared_ptr<_node>* slot = &root;
+        for (unsigned s = shift; s > 0; s -= Bits) {
+            slot = &static_cast<_inner*>(_own(*slot, false))->children[(i >> s) & _mask];
+        }
+        if ((i & _mask) == 0) {
+            // `IwšAӤƻs
+            slot->reset();
+        }
+        else {
+            static_cast<_leaf*>(_own(*slot, true))->items.pop_back();
+        }
+        // uѤUĤ@Ӥl`IdɡAhlڸ`I
+        while (shift > 0 && _size <= (chunk_size << (shift - Bits))) {
+            root = std::shared_ptr<_node>(static_cast<_inner*>(root.get())->children[0]);
+            shift -= Bits;
+        }
+    }
+    void clear() noexcept {
+        root.reset();
+        _size = 0;
+        shift = 0;
+    }
+    // HnvalueNҦAϥηs`I
+    void assign(std::size_t n, const T& value) {
+        clear();
+        for (std::size_t i = 0; i < n; ++i) {
+            push_back(value);
+        }
+    }
+    // ̯޶ǹCӤIsf(const T&)ACӸ`IuݨX@|
+    template <class F>
+    void for_each(F&& f) const {
+        if (root) {
+            _for_each(root.get(), shift, f);
+        }
+    }
+private:
+    [[nodiscard]] static std::uint64_t _new_edit() noexcept {
+        static std::atomic<std::uint64_t> counter{ 0 };
+        return counter.fetch_add(1, std::memory_order_relaxed) + 1;
+    }
+    [[nodiscard]] std::shared_ptr<_leaf> _new_leaf() const {
+        auto leaf = std::make_shared<_leaf>();
+        leaf->edit = edit;
+        leaf->items.reserve(chunk_size);
+        return leaf;
+    }
+    [[nodiscard]] std::shared_ptr<_inner> _new_inner() const {
+        auto inner = std::make_shared<_inner>();
+        inner->edit = edit;
+        return inner;
+    }
+    // TOslotV`IݩۤvA_hHƥN
+    _node* _own(std::shared_ptr<_node>& slot, bool leaf) {
+        if (slot->edit != edit) {
+            if (leaf) {
+                auto copy = std::make_shared<_leaf>(*static_cast<const _leaf*>(slot.get()));
+                copy->edit = edit;
+                slot = std::move(copy);
+            }
+            else {
+                auto copy = std::make_shared<_inner>(*static_cast<const _inner*>(slot.get()));
+                copy->edit = edit;
+                slot = std::move(copy);
+            }
+        }
+        return slot.get();
+    }
+    template <class F>
+    static void _for_each(const _node* now, unsigned s, F& f) {
+        if (s == 0) {
+            for (const T& item : static_cast<const _leaf*>(now)->items) {
+                f(item);
+            }
+            return;
+        }
+        for (const auto& child : static_cast<const _inner*>(now)->children) {
+            if (child) {
+                _for_each(child.get(), s - Bits, f);
+            }
+        }
+    }
+};
+
+// @gJ̡BhŪ̪X
+// gJ̦bZWJPAIspublish()osFŪ̥Hacquire()o̷so(snapshot)
+// snapshotiקBHѦҭpƺ޲zAo᪺jMݭnέlާ@A]|ݨ줧᪺ק
+// acquire()Ppublish()ëDLGstd::atomic<std::shared_ptr>blibstdc++H۱@A
+// 䴩зǨ禡w(Ҧplibc++)hstd::atomic_load/std::atomic_storeAq`H쪺mutex@
+// forward_listsPsbsbh_persistent_vectorAU@Υק諸϶
+// oOO(1)A⦸oCӳQק諸϶uƻs@A]CӪPק諸ƶqAӤOPƶq
+// ҥ~OrehashGر}C|קҦ`IA᪺Ĥ@ӪPe@Υ϶
+//
+// wGacquire()iHP󦨭禡PɩIsFsnapshotiHQNhӰPɨϥ
+// l禡(]Apublish())uѦP@ӼgJ̩Is
+template <
+    class Key,
+    class Hash = std::hash<Key>,
+    class Pred = std::equal_to<Key>,
+    class BucketPolicy = sbh_prime_modulo,
+    class Index = std::uint32_t,
+    unsigned ChunkBits = 6>
+class snapshot_single_buffer_hash_set {
+public:
+    using key_type = Key;
+    using value_type = Key;
+    using hasher = Hash;
+    using key_equal = Pred;
+    using size_type = Index;
+    using index = Index;
+    using const_reference = const value_type&;
+    static constexpr index npos = static_cast<index>(-1);
+    [[nodiscard]] static constexpr size_type max_size() noexcept {
+        return npos - 1;
+    }
+    [[nodiscard]] static constexpr size_type max_bucket_count() noexcept {
+        return static_cast<size_type>(BucketPolicy::round_up(
+            (std::numeric_limits<size_type>::max)(), (std::numeric_limits<size_type>::max)()));
+    }
+private:
+    // Psingle_buffer_hash_set`IۦPA@ߧ֨ƭȡArehashɤsp
+    struct Node {
+        value_type payload;
+        index next;
+        std::size_t hash_code;
+    };
+    static constexpr bool _is_transparent = requires {
+        typename Hash::is_transparent;
+        typename Pred::is_transparent;
+    };
+    // @Ӫ㤺eAoᤣA
+    struct _version {
+        sbh_persistent_vector<Node, ChunkBits> forward_lists;
+        sbh_persistent_vector<index, ChunkBits> buckets;
+        [[no_unique_address]] [[msvc::no_unique_address]] hasher hash;
+        [[no_unique_address]] [[msvc::no_unique_address]] key_equal equal;
+        [[no_unique_address]] [[msvc::no_unique_address]] BucketPolicy bucket_policy;
+        template <class K>
+        [[nodiscard]] index find(const K& value, std::size_t hash_code) const {
+            if (buckets.empty()) {
+                return npos;
+            }
+            index now = buckets[bucket_policy(hash_code, buckets.size())];
+            while (now != npos) {
+                const Node& node = forward_lists[now];
+                if (node.hash_code == hash_code && equal(value, node.payload)) {
+                    return now;
+                }
+                now = node.next;
+            }
+            return npos;
+        }
+    };
+public:
+    // Y@ӤwoAƻsuW[Ѧҭp
+    class snapshot {
+        std::shared_ptr<const _version> version;
+        friend class snapshot_single_buffer_hash_set;
+        explicit snapshot(std::shared_ptr<const _version> Version) noexcept :version(std::move(Version)) {}
+    public:
+        snapshot() noexcept = default;
+        [[nodiscard]] size_type size() const noexcept {
+            return version ? static_cast<size_type>(version->forward_lists.size()) : 0;
+        }
+        [[nodiscard]] bool empty() const noexcept {
+            return size() == 0;
+        }
+        [[nodiscard]] size_type bucket_count() const noexcept {
+            return version ? static_cast<size_type>(version->buckets.size()) : 0;
+        }
+        [[nodiscard]] const_reference operator[](index i) const noexcept {
+            assert(version && i < size());
+            return version->forward_lists[i].payload;
+        }
+        [[nodiscard]] index _index_find(const key_type& key) const {
+            return version ? version->find(key, version->hash(key)) : npos;
+        }
+        template <class K>
+            requires _is_transparent
+        [[nodiscard]] index _index_find(const K& key) const {
+            return version ? version->find(key, version->hash(key)) : npos;
+        }
+        [[nodiscard]] bool contains(const key_type& key) const {
+            return _index_find(key) != npos;
+        }
+        template <class K>
+            requires _is_transparent
+        [[nodiscard]] bool contains(const K& key) const {
+            return _index_find(key) != npos;
+        }
+        [[nodiscard]] size_type count(const key_type& key) const {
+            return contains(key);
+        }
+        template <class K>
+            requires _is_transparent
+        [[nodiscard]] size_type count(const K& key) const {
+            return contains(key);
+        }
+        // ̯޶ǹCӤIsf(const Key&)
+        template <class F>
+        void for_each(F f) const {
+            if (version) {
+                version->forward_lists.for_each([&](const Node& node) {
+                    f(node.payload);
+                });
+            }
+        }
+    };
+
+    explicit snapshot_single_buffer_hash_set(size_type bucket_count = 0, const hasher& hashFunction = hasher(), const key_equal& equalFunction = key_equal())
+        : draft{ {}, {}, hashFunction, equalFunction, {} } {
+        rehash(bucket_count);
+        publish();
+    }
+    snapshot_single_buffer_hash_set(const snapshot_single_buffer_hash_set&) = delete;
+    snapshot_single_buffer_hash_set& operator=(const snapshot_single_buffer_hash_set&) = delete;
+
+    // NثeZosæ^ǡAIsacquire()Ū̳|o
+    // wgoªṲ̄vTAªb̫@snapshotѺc
+    snapshot publish() {
+        auto version = std::make_shared<const _version>(_version{
+            draft.forward_lists.share(), draft.buckets.share(), draft.hash, draft.equal, draft.bucket_policy });
+#if defined(__cpp_lib_atomic_shared_ptr)
+        current.store(version, std::memory_order_release);
+#else
+        std::atomic_store_explicit(&current, version, std::memory_order_release);
+#endif
+        return snapshot(std::move(version));
+    }
+    // o̷soAiHPgJ̦PɩIs
+    [[nodiscard]] snapshot acquire() const {
+#if defined(__cpp_lib_atomic_shared_ptr)
+        return snapshot(current.load(std::memory_order_acquire));
+#else
+        return snapshot(std::atomic_load_explicit(&current, std::memory_order_acquire));
+#endif
+    }
+
+    // HU禡@Ω|oZAuѼgJ̩Is
+    std::pair<index, bool> insert(const value_type& value) {
+        return _insert_impl(value);
+    }
+    std::pair<index, bool> insert(value_type&& value) {
+        return _insert_impl(std::move(value));
+    }
+    template <class... Args>
+    std::pair<index, bool> emplace(Args&&... args) {
+        return _insert_impl(value_type(std::forward<Args>(args)...));
+    }
+    size_type erase(const key_type& key) {
+        return _erase_impl(key);
+    }
+    template <class K>
+        requires _is_transparent
+    size_type erase(const K& key) {
+        return _erase_impl(key);
+    }
+    [[nodiscard]] index _index_find(const key_type& key) const {
+        return draft.find(key, draft.hash(key));
+    }
+    template <class K>
+        requires _is_transparent
+    [[nodiscard]] index _index_find(const K& key) const {
+        return draft.find(key, draft.hash(key));
+    }
+    [[nodiscard]] bool contains(const key_type& key) const {
+        return _index_find(key) != npos;
+    }
+    template <class K>
+        requires _is_transparent
+    [[nodiscard]] bool contains(const K& key) const {
+        return _index_find(key) != npos;
+    }
+    [[nodiscard]] size_type count(const key_type& key) const {
+        return contains(key);
+    }
+    template <class K>
+        requires _is_transparent
+    [[nodiscard]] size_type count(const K& key) const {
+        return contains(key);
+    }
+    [[nodiscard]] const_reference operator[](index i) const noexcept {
+        assert(i < size());
+        return draft.forward_lists[i].payload;
+    }
+    [[nodiscard]] size_type size() const noexcept {
+        return static_cast<size_type>(draft.forward_lists.size());
+    }
+    [[nodiscard]] bool empty() const noexcept {
+        return draft.forward_lists.empty();
+    }
+    [[nodiscard]] size_type bucket_count() const noexcept {
+        return static_cast<size_type>(draft.buckets.size());
+    }
+    [[nodiscard]] float load_factor() const noexcept {
+        return bucket_count() ? float(size()) / float(bucket_count()) : 0;
+    }
+    [[nodiscard]] float max_load_factor() const noexcept {
+        return maximum_load_factor;
+    }
+    void max_load_factor(float factor) noexcept {
+        maximum_load_factor = factor;
+    }
+    // ر}Cís걵ҦA|קҦ϶
+    void rehash(size_type nbuckets) {
+        nbuckets = (std::max)(nbuckets, _bucket_count_for(size()));
+        if (nbuckets <= bucket_count()) {
+            return;
+        }
+        nbuckets = static_cast<size_type>(BucketPolicy::round_up(nbuckets, max_bucket_count()));
+        draft.buckets.assign(nbuckets, npos);
+        draft.bucket_policy.assign(nbuckets);
+        for (index i = 0; i < size(); ++i) {
+            Node& node = draft.forward_lists.mutable_at(i);
+            index& head = draft.buckets.mutable_at(draft.bucket_policy(node.hash_code, nbuckets));
+            node.next = head;
+            head = i;
+        }
+    }
+    void reserve(size_type n) {
+        rehash(_bucket_count_for(n));
+    }
+    void clear() noexcept {
+        draft.forward_lists.clear();
+        draft.buckets.clear();
+        draft.bucket_policy.assign(0);
+    }
+    [[nodiscard]] hasher hash_function() const noexcept(noexcept(hasher(draft.hash))) {
+        return draft.hash;
+    }
+    [[nodiscard]] key_equal key_eq() const noexcept(noexcept(key_equal(draft.equal))) {
+        return draft.equal;
+    }
+private:
+    _version draft;
+#if defined(__cpp_lib_atomic_shared_ptr)
+    std::atomic<std::shared_ptr<const _version>> current;
+#else
+    std::shared_ptr<const _version> current;
+#endif
+    float maximum_load_factor = 1.0f;
+
+    [[nodiscard]] size_type _bucket_count_for(std::size_t n) const noexcept {
+        double required = double(n) / max_load_factor();
+        return required >= double(max_bucket_count()) ?
+            max_bucket_count() :
+            static_cast<size_type>(required);
+    }
+    template <class LRvalue_type>
+    std::pair<index, bool> _insert_impl(LRvalue_type&& value) {
+        std::size_t hash_code = draft.hash(value);
+        if (index exist_element = draft.find(value, hash_code); exist_element != npos) {
+            return { exist_element, false };
+        }
+        if (size() == max_size()) [[unlikely]] {
+            throw std::length_error("snapshot_single_buffer_hash_set too long");
+        }
+        if (bucket_count() == 0 || static_cast<float>(size() + 1) / bucket_count() > max_load_factor()) {
+            std::size_t required = BucketPolicy::grow(bucket_count(), _bucket_count_for(std::size_t(size()) + 8));
+            rehash(static_cast<size_type>((std::min<std::size_t>)(required, max_bucket_count())));
+        }
+        index& head = draft.buckets.mutable_at(draft.bucket_policy(hash_code, bucket_count()));
+        index position = size();
+        draft.forward_lists.push_back(Node{ std::forward<LRvalue_type>(value), head, hash_code });
+        head = position;
+        return { position, true };
+    }
+    // Psingle_buffer_hash_setۦPANqAAH̫@Ӥɪů
+    template <class K>
+    size_type _erase_impl(const K& value) {
+        if (bucket_count() == 0) {
+            return 0;
+        }
+        std::size_t hash_code = draft.hash(value);
+        index nbucket = static_cast<index>(draft.bucket_policy(hash_code, bucket_count()));
+        index before = npos;
+        index now = draft.buckets[nbucket];
+        while (now != npos) {
+            const Node& node = draft.forward_lists[now];
+            if (node.hash_code == hash_code && draft.equal(value, node.payload)) {
+                break;
+            }
+            before = now;
+            now = node.next;
+        }
+        if (now == npos) {
+            return 0;
+        }
+        index after = draft.forward_lists[now].next;
+        if (before == npos) {
+            draft.buckets.mutable_at(nbucket) = after;
+        }
+        else {
+            draft.forward_lists.mutable_at(before).next = after;
+        }
+        index last = size() - 1;
+        if (now != last) {
+            // NV̫@Ӥθ`IאּVnowAA̫@Ӥnow
+            index last_bucket = static_cast<index>(draft.bucket_policy(draft.forward_lists[last].hash_code, bucket_count()));
+            if (draft.buckets[last_bucket] == last) {
+                draft.buckets.mutable_at(last_bucket) = now;
+            }
+            else {
+                index previous = draft.buckets[last_bucket];
+                while (draft.forward_lists[previous].next != last) {
+                    previous = draft.forward_lists[previous].next;
+                }
+                draft.forward_lists.mutable_at(previous).next = now;
+            }
+            Node moved = std::move(draft.forward_lists.mutable_at(last));
+            draft.forward_lists.mutable_at(now) = std::move(moved);
+        }
+        draft.forward_lists.pop_back();
+        return 1;
+    }
+};
+#else
+#error C++20 or later required
+#endif // _HAS_CXX20
+#endif // SNAPSHOT_SINGLE_BUFFER_HASH_SET
\ No newline at end of file
@@ -0,0 +1,262 @@
+#pragma once
+#ifndef STATIC_SINGLE_BUFFER_HASH_SET
+#define STATIC_SINGLE_BUFFER_HASH_SET
+#include "single_buffer_hash_set.h"
+#include <array>
+#include <cstddef>
+#include <string_view>
+#if _HAS_CXX20 || __cplusplus >= 202002L
+// bsĶغcŪXAAXrBObظmɴNwTw
+// غcHconstexprܼƫOsɡAӪŪưϬqAݭnl
+//
+// PAutoRehashfalsesingle_buffer_hash_setۦPAeqPƦbغcɴNwTwAغcᤣAJβ
+// ̿JǦsAƪuOdĤ@
+// ޥѫƭȻPؤlVXHfastrangepFغcɥiHզhӺؤlAXI̤֪@
+// SIؤlɡACjMuݭnŪ@ӱP@
+
+// ib`ƨDȤϥΪƨ
+// std::hashOconstexprA]H`ƨDȫغcsingle_buffer_hash_setstatic_single_buffer_hash_setɥiHΦO
+// ƻPC|ഫA浹ުp⥴Frϥ64줸FNV-1a
+// ҥβdAiHconst char*std::stringjMstd::string_view
+struct sbh_constexpr_hash {
+    using is_transparent = void;
+    template <class T>
+        requires (std::is_integral_v<T> || std::is_enum_v<T>)
+    constexpr std::size_t operator()(T value) const noexcept {
+        if constexpr (std::is_enum_v<T>) {
+            return static_cast<std::size_t>(static_cast<std::underlying_type_t<T>>(value));
+        }
+        else {
+            return static_cast<std::size_t>(value);
+        }
+    }
+    template <class CharT, class Traits>
+    constexpr std::size_t operator()(std::basic_string_view<CharT, Traits> value) const noexcept {
+        std::uint64_t result = 14695981039346656037ull;
+        for (CharT c : value) {
+            result = (result ^ static_cast<std::uint64_t>(static_cast<std::make_unsigned_t<CharT>>(c))) * 1099511628211ull;
+        }
+        return static_cast<std::size_t>(result);
+    }
+    template <class T>
+        requires (!std::is_integral_v<std::remove_cvref_t<T>> && !std::is_enum_v<std::remove_cvref_t<T>>
+            && std::is_convertible_v<const T&, std::string_view>)
+    constexpr std::size_t operator()(const T& value) const noexcept {
+        return (*this)(std::string_view(value));
+    }
+};
+
+// TweqŪX
+// Keyb`ƨDȤϥΥBiZѺcAҦpơBC|Pstd::string_view
+// BucketCountw]eq⭿AVhVeSIؤl
+template <
+    class Key,
+    std::size_t Capacity,
+    class Hash = sbh_constexpr_hash,
+    class Pred = std::equal_to<>,
+    class Index = std::uint32_t,
+    std::size_t BucketCount = Capacity * 2>
+class static_single_buffer_hash_set {
+    static_assert(std::is_trivially_destructible_v<Key>, "keys must be trivially destructible to live in read-only data");
+    static_assert(BucketCount > 0, "at least one bucket is required");
+public:
+    using key_type = Key;
+    using value_type = Key;
+    using hasher = Hash;
+    using key_equal = Pred;
+    using hash_code_type = std::size_t;
+    using size_type = Index;
+    using index = Index;
+    using const_reference = const value_type&;
+    using const_iterator = const value_type*;
+    using iterator = const_iterator;
+    static constexpr index npos = static_cast<index>(-1);
+    static_assert(Capacity < npos && BucketCount <= npos, "Index is too small for this capacity");
+private:
+    std::array<Key, Capacity> keys{};
+    std::array<index, Capacity> next{};
+    std::array<index, BucketCount> buckets{};
+    size_type _size = 0;
+    std::uint64_t seed = 0;
+    bool _collision_free = true;
+    [[no_unique_address]] [[msvc::no_unique_address]] hasher hash;
+    [[no_unique_address]] [[msvc::no_unique_address]] key_equal equal;
+    static constexpr bool _is_transparent = requires {
+        typename Hash::is_transparent;
+        typename Pred::is_transparent;
+    };
+public:
+    // H[first, last)غcA۲WLCapacityɩߥXstd::length_errorA`ƨDȮɧYsĶ~
+    // seed_attemptsB~ժؤlƶqA0ܥuϥιw]ؤlFSIؤlɥߧY
+    template <std::input_iterator InputIt, std::sentinel_for<InputIt> Sentinel>
+    constexpr static_single_buffer_hash_set(InputIt first, Sentinel last, std::size_t seed_attempts = 0, const hasher& hashFunction = hasher(), const key_equal& equalFunction = key_equal())
+        : hash(hashFunction), equal(equalFunction) {
+        std::array<std::size_t, Capacity> hash_codes{};
+        for (; first != last; ++first) {
+            const Key& key = *first;
+            std::size_t hash_code = hash(key);
+            if (_index_find_linear(key, hash_code, hash_codes) != npos) {
+                continue;
+            }
+            if (_size == Capacity) {
+                throw std::length_error("static_single_buffer_hash_set: too many keys");
+            }
+            keys[_size] = key;
+            hash_codes[_size] = hash_code;
+            ++_size;
+        }
+        std::uint64_t best_seed = 0;
+        std::size_t best_collisions = _link(best_seed, hash_codes);
+        for (std::size_t attempt = 1; attempt <= seed_attempts && best_collisions != 0; ++attempt) {
+            std::uint64_t candidate = _seed_of(attempt);
+            std::size_t collisions = _link(candidate, hash_codes);
+            if (collisions < best_collisions) {
+                best_seed = candidate;
+                best_collisions = collisions;
+            }
+        }
+        _link(best_seed, hash_codes);
+        seed = best_seed;
+        _collision_free = best_collisions == 0;
+    }
+
+    [[nodiscard]] constexpr const_iterator begin() const noexcept {
+        return keys.data();
+    }
+    [[nodiscard]] constexpr const_iterator end() const noexcept {
+        return keys.data() + _size;
+    }
+    [[nodiscard]] constexpr size_type size() const noexcept {
+        return _size;
+    }
+    [[nodiscard]] constexpr bool empty() const noexcept {
+        return _size == 0;
+    }
+    [[nodiscard]] static constexpr size_type capacity() noexcept {
+        return static_cast<size_type>(Capacity);
+    }
+    [[nodiscard]] static constexpr size_type bucket_count() noexcept {
+        return static_cast<size_type>(BucketCount);
+    }
+    // Cӱܦhu@ӤAҦjMuݭn@
+    [[nodiscard]] constexpr bool collision_free() const noexcept {
+        return _collision_free;
+    }
+    [[nodiscard]] constexpr const_reference operator[](index i) const noexcept {
+        assert(i < _size);
+        return keys[i];
+    }
+    [[nodiscard]] constexpr index _index_find(const key_type& keyval) const
+        noexcept(noexcept(hash(std::declval<const key_type&>())) && noexcept(equal(std::declval<const key_type&>(), std::declval<const key_type&>()))) {
+        return _index_find_hetero(keyval);
+    }
+    template <class K>
+        requires _is_transparent
+    [[nodiscard]] constexpr index _index_find(const K& keyval) const
+        noexcept(noexcept(hash(std::declval<const K&>())) && noexcept(equal(std::declval<const K&>(), std::declval<const key_type&>()))) {
+        return _index_find_hetero(keyval);
+    }
+    [[nodiscard]] constexpr const_iterator find(const key_type& keyval) const {
+        index temp = _index_find_hetero(keyval);
+        return temp == npos ?
+            end() :
+            begin() + temp;
+    }
+    template <class K>
+        requires _is_transparent
+    [[nodiscard]] constexpr const_iterator find(const K& keyval) const {
+        index temp = _index_find_hetero(keyval);
+        return temp == npos ?
+            end() :
+            begin() + temp;
+    }
+    [[nodiscard]] constexpr size_type count(const key_type& key) const {
+        return _index_find_hetero(key) != npos;
+    }
+    template <class K>
+        requires _is_transparent
+    [[nodiscard]] constexpr size_type count(const K& key) const {
+        return _index_find_hetero(key) != npos;
+    }
+    [[nodiscard]] constexpr bool contains(const key_type& key) const {
+        return _index_find_hetero(key) != npos;
+    }
+    template <class K>
+        requires _is_transparent
+    [[nodiscard]] constexpr bool contains(const K& key) const {
+        return _index_find_hetero(key) != npos;
+    }
+    [[nodiscard]] constexpr hasher hash_function() const noexcept(noexcept(hasher(hash))) {
+        return hash;
+    }
+    [[nodiscard]] constexpr key_equal key_eq() const noexcept(noexcept(key_equal(equal))) {
+        return equal;
+    }
+private:
+    // attemptӭԿؤlAHұ`ƪƨϦUӺؤl줸
+    [[nodiscard]] static constexpr std::uint64_t _seed_of(std::size_t attempt) noexcept {
+        return static_cast<std::uint64_t>(attempt) * 0x9E3779B97F4A7C15ull;
+    }
+    // PؤlVX᭼W_Ʊ`ơAϥuC줸Pƭ(Ҧpƥ)]줣P
+    [[nodiscard]] static constexpr index _bucket_of(std::uint64_t Seed, std::size_t hash_code) noexcept {
+        std::uint64_t mixed = (static_cast<std::uint64_t>(hash_code) ^ Seed) * 0xD6E8FEB86659FD93ull;
+        return static_cast<index>(sbh_mulhi64(mixed, BucketCount));
+    }
+    // HSeeds걵ҦA^ǸbDűƶq
+    constexpr std::size_t _link(std::uint64_t Seed, const std::array<std::size_t, Capacity>& hash_codes) noexcept {
+        std::size_t collisions = 0;
+        buckets.fill(npos);
+        // ѫ᩹e걵AϨC̿JǱƦC
+        for (size_type i = _size; i-- > 0;) {
+            index& head = buckets[_bucket_of(Seed, hash_codes[i])];
+            collisions += head != npos;
+            next[i] = head;
+            head = i;
+        }
+        return collisions;
+    }
+    // غcɩ|걵Aw[J
+    template <class K>
+    [[nodiscard]] constexpr index _index_find_linear(const K& value, std::size_t hash_code, const std::array<std::size_t, Capacity>& hash_codes) const {
+        for (size_type i = 0; i < _size; ++i) {
+            if (hash_codes[i] == hash_code && equal(value, keys[i])) {
+                return i;
+            }
+        }
+        return npos;
+    }
+    template <class K>
+    [[nodiscard]] constexpr index _index_find_hetero(const K& value) const {
+        index now = buckets[_bucket_of(seed, hash(value))];
+        while (now != npos) {
+            if (equal(value, keys[now])) {
+                return now;
+            }
+            now = next[now];
+        }
+        return npos;
+    }
+};
+
+// H}Cغcstatic_single_buffer_hash_setAeqY}C
+// constexpr auto keywords = make_static_set<std::string_view>({ "if", "else", "while" });
+template <
+    class Key,
+    class Hash = sbh_constexpr_hash,
+    class Pred = std::equal_to<>,
+    class Index = std::uint32_t,
+    std::size_t N>
+[[nodiscard]] constexpr static_single_buffer_hash_set<Key, N, Hash, Pred, Index> make_static_set(const Key(&keys)[N], std::size_t seed_attempts = 0, const Hash& hashFunction = Hash(), const Pred& equalFunction = Pred()) {
+    return static_single_buffer_hash_set<Key, N, Hash, Pred, Index>(std::begin(keys), std::end(keys), seed_attempts, hashFunction, equalFunction);
+}
+// HDOҪOѼƵXƩΦC|AҦpmake_static_set<2, 3, 5, 7>()
+template <auto First, auto... Rest>
+[[nodiscard]] constexpr auto make_static_set(std::size_t seed_attempts = 0) {
+    using Key = std::common_type_t<decltype(First), decltype(Rest)...>;
+    const Key keys[] = { static_cast<Key>(First), static_cast<Key>(Rest)... };
+    return make_static_set<Key>(keys, seed_attempts);
+}
+#else
+#error C++20 or later required
+#endif // _HAS_CXX20
+#endif // STATIC_SINGLE_BUFFER_HASH_SET
\ No newline at end of file
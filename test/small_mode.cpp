@@ -0,0 +1,69 @@
+// pҦ
+// sĶ(ݭnC++20ANDEBUGP_qL)G
+//   g++ -std=c++20 -O2 -DNDEBUG -I.. small_mode.cpp -o small_mode
+//   cl /std:c++20 /O2 /DNDEBUG /EHsc /I.. small_mode.cpp
+// G
+//   ./small_mode
+// qLɦ^0A_hXѪبæ^1
+#include "single_buffer_hash_map.h"
+#include <cstdio>
+#include <string>
+
+static int failures = 0;
+#define CHECK(condition) \
+    do { \
+        if (!(condition)) { \
+            std::printf("%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #condition); \
+            ++failures; \
+        } \
+    } while (0)
+
+// w]غceS}CAiH0
+template <class Set, class Make>
+static void check_bucket_interface(Make make) {
+    Set set;
+    CHECK(set.bucket_count() == 0);
+    CHECK(set.bucket(make(1)) == 0);
+    CHECK(set.bucket_size(0) == 0);
+    CHECK(set.load_factor() == 0);
+    for (int i = 0; i < int(Set::small_size); ++i) {
+        set.insert(make(i));
+        CHECK(set.bucket_count() == 0);
+        CHECK(set.bucket(make(i)) == 0);
+        CHECK(set.bucket_size(set.bucket(make(i))) == 0);
+    }
+    // WLsmall_sizeإ߱}CACӤbucket^Ǫ
+    set.insert(make(int(Set::small_size)));
+    CHECK(set.bucket_count() > 0);
+    std::size_t total = 0;
+    for (std::size_t n = 0; n < set.bucket_count(); ++n) {
+        total += set.bucket_size(n);
+    }
+    CHECK(total == set.size());
+    for (int i = 0; i <= int(Set::small_size); ++i) {
+        CHECK(set.bucket(make(i)) < set.bucket_count());
+        CHECK(set.bucket_size(set.bucket(make(i))) > 0);
+    }
+}
+
+int main() {
+    check_bucket_interface<single_buffer_hash_set<int>>([](int i) { return i; });
+    check_bucket_interface<single_buffer_hash_set<std::string>>([](int i) { return std::to_string(i); });
+    {
+        single_buffer_hash_set<int> set;
+        set.insert(1);
+        CHECK(set.bucket(1) == 0 && set.bucket_size(0) == 0);
+        CHECK(set.contains(1) && set.size() == 1);
+    }
+    {
+        single_buffer_hash_map<int, int> map;
+        map.emplace(1, 2);
+        CHECK(map.bucket_count() == 0);
+        CHECK(map.bucket(1) == 0);
+        CHECK(map.bucket_size(0) == 0);
+    }
+    if (failures == 0) {
+        std::puts("all tests passed");
+    }
+    return failures == 0 ? 0 : 1;
+}
\ No newline at end of file